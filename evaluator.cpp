@@ -3,8 +3,16 @@
 
 #include <Benchmarker.hpp>
 #include <CLI/CLI.hpp>
+#include <filesystem>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <tbb/tbb.h>
 #include <thread>
+#include <unistd.h>
 
 struct arguments
 {
@@ -12,6 +20,7 @@ struct arguments
     ParseMode parse_mode;
     bool skip_line;
     std::string seed_file_path;
+    std::optional<std::string> manifest_path;
     std::string solver_name;
     std::size_t simulations;
     DiffusionModel diffusion_model;
@@ -20,6 +29,15 @@ struct arguments
     bool inverse_graph;
     bool backwards_diffusion;
     bool random_edge_weights;
+    std::optional<float> uniform_probability;
+    bool relabel_ids;
+    ReorderStrategy reorder_strategy;
+    std::uint64_t seed;
+    std::optional<double> relative_error;
+    double confidence;
+    bool spread_curve;
+    bool serve;
+    std::optional<std::string> socket_path;
 };
 
 auto parseEvaluatorArguments(int argc, char* argv[])
@@ -29,6 +47,7 @@ auto parseEvaluatorArguments(int argc, char* argv[])
 
     std::string graph_path;
     std::string seed_set_path;
+    std::optional<std::string> manifest_path = std::nullopt;
     std::string solver = "Unknown";
     int threads = static_cast<int>(std::thread::hardware_concurrency());
     std::size_t simulations = 20000;
@@ -37,8 +56,17 @@ auto parseEvaluatorArguments(int argc, char* argv[])
     bool backwards_activation = false;
     bool skip = false;
     bool random_edge_weights = false;
+    std::optional<float> uniform_probability = std::nullopt;
+    bool relabel_ids = false;
     ParseMode parse_mode = ParseMode::VERTEX_LIST;
     DiffusionModel diffusion_model = DiffusionModel::INDEPENDENT_CASCADE;
+    ReorderStrategy reorder_strategy = ReorderStrategy::NONE;
+    std::optional<std::uint64_t> seed = std::nullopt;
+    std::optional<double> relative_error = std::nullopt;
+    double confidence = 0.95;
+    bool spread_curve = false;
+    bool serve = false;
+    std::optional<std::string> socket_path = std::nullopt;
 
     app.add_option("-g,--graph",
                    graph_path,
@@ -47,7 +75,7 @@ auto parseEvaluatorArguments(int argc, char* argv[])
 
     app.add_option("-f,--format",
                    parse_mode,
-                   "format of the graph file (0=vertex list, 1=edge list)")
+                   "format of the graph file (0=vertex list, 1=edge list, 2=binary graph file)")
         ->required();
 
     app.add_flag("-m , --meta-data",
@@ -56,7 +84,26 @@ auto parseEvaluatorArguments(int argc, char* argv[])
 
     app.add_option("-p,--seedSetPath",
                    seed_set_path,
-                   "input file holding the ids of the seed set");
+                   "input file holding the ids of the seed set. "
+                   "If it is a directory, every file in it (recursively) is evaluated as seed set");
+
+    app.add_option("--manifest",
+                   manifest_path,
+                   "file listing the paths of the seed set files to evaluate (one per line), "
+                   "the graph is loaded only once for all of them");
+
+    app.add_flag("--spread-curve",
+                 spread_curve,
+                 "if set, the forward influence of every prefix of the seed set (first 1, 2, ..., k seeds) is appended as column");
+
+    app.add_flag("--serve",
+                 serve,
+                 "keeps the graph loaded and answers seed set queries (one per line: <simulations> <seed id> ...) "
+                 "on stdin or on the --socket, until a shutdown query");
+
+    app.add_option("--socket",
+                   socket_path,
+                   "path of the unix domain socket the --serve mode listens on. Default: stdin/stdout");
 
     app.add_option("-a,--algorithm",
                    solver,
@@ -65,12 +112,35 @@ auto parseEvaluatorArguments(int argc, char* argv[])
 
     app.add_option("-s,--simulations",
                    simulations,
-                   "number of simulations performed in the independent cascade model for verification",
+                   "number of simulations performed in the independent cascade model for verification, "
+                   "the maximum number of simulations if --precision is set",
                    true);
 
+    app.add_option("--precision",
+                   relative_error,
+                   "adaptive evaluation: simulations are run until the confidence interval of the influence "
+                   "is within the given relative error (e.g. 0.01) or the simulations are exhausted")
+        ->check(CLI::PositiveNumber);
+
+    app.add_option("--confidence",
+                   confidence,
+                   "confidence level of the --precision interval",
+                   true)
+        ->check(CLI::Range(0.5, 0.999999));
+
     app.add_option("-d,--diffusionModel",
                    diffusion_model,
-                   "Diffusion model to be used (0=IndependentCascade, 1=LinearThreshold). Default: Independent Cascade");
+                   "Diffusion model to be used (0=IndependentCascade, 1=LinearThreshold, 2=IndependentCascade bit parallel (64 simulations at once), "
+                   "3=IndependentCascade on live edge snapshots shared by all seed sets). Default: Independent Cascade");
+
+    app.add_option("--reorder",
+                   reorder_strategy,
+                   "renumbers the nodes after parsing to improve the memory locality "
+                   "(0=none, 1=degree, 2=reverse Cuthill-McKee, 3=community). Default: none");
+
+    app.add_option("--seed",
+                   seed,
+                   "seed of the random number generators. Default: random");
 
     app.add_option("-t,--threads",
                    threads,
@@ -85,6 +155,15 @@ auto parseEvaluatorArguments(int argc, char* argv[])
                  random_edge_weights,
                  "if set every the weight of every edge will be one of {0.1, 0.01, 0.001} choosen randomly at the beginning");
 
+    app.add_option("--uniform-probability",
+                   uniform_probability,
+                   "if set, every edge has the given activation probability instead of the weights of the graph")
+        ->check(CLI::Range(0.0, 1.0));
+
+    app.add_flag("-l,--relabel-ids",
+                 relabel_ids,
+                 "if set, the node ids of the graph file are compacted to 0..n-1, the seed file uses the ids of the graph file");
+
     app.add_flag("-i, --inverse",
                  use_inverse,
                  "if set, the inverse of the graph will be used");
@@ -98,11 +177,19 @@ auto parseEvaluatorArguments(int argc, char* argv[])
         std::exit(app.exit(e));
     }
 
+    if(!seed) {
+        std::random_device rd;
+        seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+        // stderr keeps the (raw) results on stdout unchanged, the run can be repeated with --seed
+        fmt::print(stderr, "random seed: {}\n", seed.value());
+    }
+
     return {
         std::move(graph_path),
         parse_mode,
         skip,
         std::move(seed_set_path),
+        std::move(manifest_path),
         solver,
         simulations,
         diffusion_model,
@@ -110,10 +197,25 @@ auto parseEvaluatorArguments(int argc, char* argv[])
         print_raw,
         use_inverse,
         backwards_activation,
-        random_edge_weights};
+        random_edge_weights,
+        uniform_probability,
+        relabel_ids,
+        reorder_strategy,
+        seed.value(),
+        relative_error,
+        confidence,
+        spread_curve,
+        serve,
+        std::move(socket_path)};
 }
 
-auto read_seed_set(const std::string& seed_path) -> std::vector<NodeId>
+/**
+ * @param internal_ids ids of the graph file to internal ids, see Graph::getInternalIds
+ */
+auto read_seed_set(const std::string& seed_path,
+                   const Graph& graph,
+                   const InternalIds& internal_ids)
+    -> std::vector<NodeId>
 {
     std::vector<NodeId> seed_set;
 
@@ -129,12 +231,354 @@ auto read_seed_set(const std::string& seed_path) -> std::vector<NodeId>
     while(std::getline(input_file, line)) {
 
         line.erase(std::remove(line.begin(), line.end(), '\n'), line.end());
-        seed_set.emplace_back(std::stol(line));
+        auto original_id = std::stol(line);
+        auto node = internal_ids.find(original_id);
+        if(!node) {
+            fmt::print("Seed {} is not a node of graph {}\n", original_id, graph.getGraphName());
+            std::exit(1);
+        }
+        seed_set.emplace_back(node.value());
     }
 
     return seed_set;
 }
 
+/**
+ * @return the seed file, all files in the seed directory (recursively, sorted)
+ * or all files listed in the manifest (one path per line, # starts a comment)
+ */
+auto collectSeedFiles(const std::string& seed_path, const std::optional<std::string>& manifest_path)
+    -> std::vector<std::string>
+{
+    namespace fs = std::filesystem;
+
+    std::vector<std::string> files;
+
+    if(manifest_path) {
+        std::ifstream manifest(manifest_path.value(), std::ios::in);
+        if(!manifest) {
+            fmt::print("Manifest {} not found\n", manifest_path.value());
+            std::exit(1);
+        }
+
+        std::string line;
+        while(std::getline(manifest, line)) {
+            if(line.empty() or line[0] == '#') {
+                continue;
+            }
+            files.emplace_back(std::move(line));
+        }
+    } else if(fs::is_directory(seed_path)) {
+        for(const auto& entry : fs::recursive_directory_iterator(seed_path)) {
+            if(entry.is_regular_file()) {
+                files.emplace_back(entry.path().string());
+            }
+        }
+        std::sort(std::begin(files), std::end(files));
+    } else {
+        files.emplace_back(seed_path);
+    }
+
+    if(files.empty()) {
+        fmt::print("No seed files found in {}\n", manifest_path.value_or(seed_path));
+        std::exit(1);
+    }
+
+    return files;
+}
+
+struct Evaluation
+{
+    double forward_influence = -1.0;
+    double backward_influence = -1.0;
+    double forward_half_width = 0.0;
+    double backward_half_width = 0.0;
+    std::size_t simulations = 0;
+    double cascading_time = 0.0;
+    // forward spread of every seed set prefix, only with --spread-curve
+    std::vector<double> spread_curve;
+};
+
+/**
+ * @param simulations number of simulations, the budget of the adaptive evaluation if --precision is set
+ */
+auto evaluateSeedSet(const DiffusionModelInterface& diffusion_evaluator,
+                     const std::vector<NodeId>& seed_set,
+                     std::size_t simulations,
+                     const arguments& args)
+    -> Evaluation
+{
+    Evaluation evaluation;
+    evaluation.simulations = simulations;
+
+    Timer t;
+
+    if(args.relative_error) {
+        const auto target = PrecisionTarget{args.relative_error.value(), args.confidence, simulations};
+
+        const auto forward = estimateInfluence(diffusion_evaluator, seed_set, false, target);
+        evaluation.forward_influence = forward.influence;
+        evaluation.forward_half_width = forward.half_width;
+        evaluation.simulations = forward.simulations;
+
+        if(args.backwards_diffusion) {
+            const auto backward = estimateInfluence(diffusion_evaluator, seed_set, true, target);
+            evaluation.backward_influence = backward.influence;
+            evaluation.backward_half_width = backward.half_width;
+        }
+    } else {
+        evaluation.forward_influence = diffusion_evaluator.cascadeForwardN(seed_set, simulations);
+        if(args.backwards_diffusion) {
+            evaluation.backward_influence = diffusion_evaluator.cascadeBackwardN(seed_set, simulations);
+        }
+    }
+
+    evaluation.cascading_time = t.elapsed();
+
+    if(args.spread_curve) {
+        evaluation.spread_curve = diffusion_evaluator.cascadeForwardCurveN(seed_set, simulations);
+    }
+
+    return evaluation;
+}
+
+/**
+ * stream buffer over a connected socket, the queries of a client are read and answered line by line
+ */
+class SocketBuffer final : public std::streambuf
+{
+public:
+    explicit SocketBuffer(int socket) noexcept
+        : socket_(socket)
+    {
+        setg(input_.data(), input_.data(), input_.data());
+        setp(output_.data(), output_.data() + output_.size());
+    }
+
+    SocketBuffer(const SocketBuffer&) = delete;
+    auto operator=(const SocketBuffer&) -> SocketBuffer& = delete;
+
+    ~SocketBuffer() override
+    {
+        sync();
+        ::close(socket_);
+    }
+
+protected:
+    auto underflow()
+        -> int_type override
+    {
+        const auto received = ::recv(socket_, input_.data(), input_.size(), 0);
+        if(received <= 0) {
+            return traits_type::eof();
+        }
+
+        setg(input_.data(), input_.data(), input_.data() + received);
+        return traits_type::to_int_type(input_[0]);
+    }
+
+    auto overflow(int_type c)
+        -> int_type override
+    {
+        if(sync() != 0) {
+            return traits_type::eof();
+        }
+        if(!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    auto sync()
+        -> int override
+    {
+        const auto* data = pbase();
+        while(data < pptr()) {
+            // a client which disconnected must not kill the server with SIGPIPE
+            const auto sent = ::send(socket_, data, static_cast<std::size_t>(pptr() - data), MSG_NOSIGNAL);
+            if(sent <= 0) {
+                setp(output_.data(), output_.data() + output_.size());
+                return -1;
+            }
+            data += sent;
+        }
+
+        setp(output_.data(), output_.data() + output_.size());
+        return 0;
+    }
+
+private:
+    int socket_;
+    std::array<char, 4096> input_;
+    std::array<char, 4096> output_;
+};
+
+/**
+ * answers seed set queries on a loaded graph, the diffusion model (and its snapshot pool) stays warm between queries.
+ *
+ * Protocol, one request and one response per line:
+ *   <simulations> <seed id> <seed id> ...   ->  ok <forward> <backward> <simulations> <latency ms> [<spread curve>]
+ *   stats                                   ->  ok <queries> <mean ms> <p50 ms> <p95 ms> <max ms>
+ *   quit                                    ends the connection
+ *   shutdown                                ends the connection and stops the server
+ * Seed ids are the ids of the graph file, simulations 0 uses the -s value.
+ * Malformed queries are answered with: error <message>
+ */
+class QueryServer
+{
+public:
+    QueryServer(const Graph& graph,
+                const DiffusionModelInterface& diffusion_evaluator,
+                const arguments& args,
+                const InternalIds& internal_ids)
+        : graph_(graph),
+          diffusion_evaluator_(diffusion_evaluator),
+          args_(args),
+          internal_ids_(internal_ids) {}
+
+    /**
+     * answers the queries of one client
+     * @return false if the client requested a shutdown
+     */
+    auto serve(std::istream& input, std::ostream& output)
+        -> bool
+    {
+        std::string line;
+        while(std::getline(input, line)) {
+            std::istringstream request(line);
+            std::string command;
+            if(!(request >> command)) {
+                continue;
+            }
+
+            if(command == "quit") {
+                return true;
+            }
+            if(command == "shutdown") {
+                return false;
+            }
+
+            output << (command == "stats" ? stats() : query(line)) << std::endl;
+        }
+
+        return true;
+    }
+
+private:
+    auto query(const std::string& line)
+        -> std::string
+    {
+        std::istringstream request(line);
+
+        long long simulations = 0;
+        if(!(request >> simulations) or simulations < 0) {
+            return "error expected: <simulations> <seed id> ...";
+        }
+
+        std::vector<NodeId> seed_set;
+        NodeId original_id;
+        while(request >> original_id) {
+            auto node = internal_ids_.find(original_id);
+            if(!node) {
+                return fmt::format("error seed {} is not a node of graph {}", original_id, graph_.getGraphName());
+            }
+            seed_set.emplace_back(node.value());
+        }
+        if(!request.eof()) {
+            return "error seed ids have to be integers";
+        }
+
+        const auto evaluation = evaluateSeedSet(diffusion_evaluator_,
+                                                seed_set,
+                                                simulations == 0 ? args_.simulations : static_cast<std::size_t>(simulations),
+                                                args_);
+
+        const auto latency = evaluation.cascading_time * 1000.0;
+        latencies_.emplace_back(latency);
+
+        auto response = fmt::format("ok {:.3f} {:.3f} {} {:.3f}",
+                                    evaluation.forward_influence,
+                                    evaluation.backward_influence,
+                                    evaluation.simulations,
+                                    latency);
+        if(args_.spread_curve) {
+            response = fmt::format("{} {}", response, formatSpreadCurve(evaluation.spread_curve));
+        }
+        return response;
+    }
+
+    auto stats() const
+        -> std::string
+    {
+        if(latencies_.empty()) {
+            return "ok 0 0 0 0 0";
+        }
+
+        auto sorted = latencies_;
+        std::sort(std::begin(sorted), std::end(sorted));
+        const auto percentile = [&](double p) {
+            return sorted[static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1))];
+        };
+        const auto sum = std::accumulate(std::begin(sorted), std::end(sorted), 0.0);
+
+        return fmt::format("ok {} {:.3f} {:.3f} {:.3f} {:.3f}",
+                           sorted.size(),
+                           sum / static_cast<double>(sorted.size()),
+                           percentile(0.5),
+                           percentile(0.95),
+                           sorted.back());
+    }
+
+    const Graph& graph_;
+    const DiffusionModelInterface& diffusion_evaluator_;
+    const arguments& args_;
+    const InternalIds& internal_ids_;
+    std::vector<double> latencies_;
+};
+
+/**
+ * accepts clients on the unix domain socket at the given path one after another until one requests a shutdown
+ */
+auto serveUnixSocket(const std::string& path, QueryServer& server)
+    -> void
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(address.sun_path)) {
+        fmt::print(stderr, "socket path {} is too long\n", path);
+        std::exit(1);
+    }
+    std::copy(std::begin(path), std::end(path), address.sun_path);
+
+    const auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    // a socket file left over by a previous server would make bind fail
+    ::unlink(path.c_str());
+    if(listener < 0
+       or ::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+       or ::listen(listener, SOMAXCONN) != 0) {
+        fmt::print(stderr, "could not listen on socket {}: {}\n", path, std::strerror(errno));
+        std::exit(1);
+    }
+
+    fmt::print(stderr, "listening on {}\n", path);
+
+    auto running = true;
+    while(running) {
+        const auto client = ::accept(listener, nullptr, nullptr);
+        if(client < 0) {
+            continue;
+        }
+
+        SocketBuffer buffer{client};
+        std::iostream stream{&buffer};
+        running = server.serve(stream, stream);
+    }
+
+    ::close(listener);
+    ::unlink(path.c_str());
+}
+
 auto main(int argc, char* argv[])
     -> int
 {
@@ -142,6 +586,10 @@ auto main(int argc, char* argv[])
     auto args = parseEvaluatorArguments(argc, argv);
 
     tbb::task_scheduler_init init(args.number_of_threads);
+    util::RandomService::setSeed(args.seed);
+
+    // in the stdin server mode stdout only carries the answers
+    const auto should_log = !args.raw_output and !(args.serve and !args.socket_path);
 
     Timer t;
     auto graph = [&] {
@@ -151,13 +599,20 @@ auto main(int argc, char* argv[])
                                        args.inverse_graph,
                                        args.skip_line,
                                        args.random_edge_weights,
-                                       !args.raw_output);
+                                       args.relabel_ids,
+                                       should_log);
         case ParseMode::EDGE_LIST:
             return parseEdgeListFile(args.graph_file_path,
                                      args.inverse_graph,
                                      args.skip_line,
                                      args.random_edge_weights,
-                                     !args.raw_output);
+                                     args.relabel_ids,
+                                     should_log);
+        case ParseMode::BINARY:
+            return parseBinaryFile(args.graph_file_path,
+                                   args.inverse_graph,
+                                   args.random_edge_weights,
+                                   should_log);
         default:
             fmt::print("unknown parse mode\n");
             std::exit(-1);
@@ -165,36 +620,97 @@ auto main(int argc, char* argv[])
     }();
     auto reading_time = t.elapsed();
 
-    auto result_set = read_seed_set(args.seed_file_path);
+    reorderGraph(graph, args.reorder_strategy, should_log);
 
-    double forward_influence;
-    auto backward_influence = -1.0;
-    t.reset();
+    if(args.uniform_probability) {
+        graph.setUniformEdgeWeights(args.uniform_probability.value());
+    }
+
+    // the seed ids of the queries and seed files are translated with one lookup structure
+    const auto internal_ids = graph.getInternalIds();
+
+    if(args.serve) {
+        const auto diffusion_evaluator = DiffusionFactory::create(args.diffusion_model, graph);
+        QueryServer server{graph, *diffusion_evaluator, args, internal_ids};
+
+        if(args.socket_path) {
+            serveUnixSocket(args.socket_path.value(), server);
+        } else {
+            server.serve(std::cin, std::cout);
+        }
+        return 0;
+    }
+
+    const auto seed_files = collectSeedFiles(args.seed_file_path, args.manifest_path);
+
+    // all seed sets are read before the evaluation, an unknown node id aborts the run early
+    std::vector<std::vector<NodeId>> seed_sets;
+    for(const auto& path : seed_files) {
+        seed_sets.emplace_back(read_seed_set(path, graph, internal_ids));
+    }
 
     auto diffusion_evaluator = DiffusionFactory::create(args.diffusion_model, graph);
 
-    forward_influence = diffusion_evaluator->cascadeForwardN(result_set, args.simulations);
-    if(args.backwards_diffusion) {
-        backward_influence = diffusion_evaluator->cascadeBackwardN(result_set, args.simulations);
-    }
-
-    auto cascading_time = t.elapsed();
-
-    auto message = fmt::format("{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\n",
-                               graph.getGraphName(),
-                               graph.getNumberOfNodes() - args.skip_line, // if skip is true, there is no node 0
-                               graph.getNumberOfEdges(),
-                               result_set.size(),
-                               args.simulations,
-                               args.solver_name,
-                               "$runtime",
-                               forward_influence,
-                               backward_influence,
-                               reading_time,
-                               cascading_time,
-                               args.number_of_threads,
-                               args.diffusion_model);
-
-    fmt::print("{}", message);
+    // the seed sets are evaluated concurrently, the simulations of every set are parallel tasks themselves.
+    // The stream families of a set are derived from a key drawn in file order, hence the results only depend on --seed.
+    // The cascading time of a set is measured inside its task
+    std::vector<std::uint64_t> family_keys(seed_sets.size());
+    for(auto& key : family_keys) {
+        key = util::RandomService::newStreamFamily();
+    }
+
+    std::vector<Evaluation> evaluations(seed_sets.size());
+    tbb::parallel_for(std::size_t{0},
+                      seed_sets.size(),
+                      [&](auto i) {
+                          const util::RandomService::FamilyScope scope{family_keys[i]};
+                          evaluations[i] = evaluateSeedSet(*diffusion_evaluator, seed_sets[i], args.simulations, args);
+                      });
+
+    const auto batch_mode = args.manifest_path or std::filesystem::is_directory(args.seed_file_path);
+    for(std::size_t i = 0; i < seed_sets.size(); ++i) {
+        const auto& evaluation = evaluations[i];
+        // the Benchmarker writes <out path>/<algorithm>/result-N.txt, hence the directory names the algorithm
+        const auto solver_name = batch_mode and args.solver_name == "Unknown"
+            ? std::filesystem::path(seed_files[i]).parent_path().filename().string()
+            : args.solver_name;
+
+        auto message = fmt::format("{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}\n",
+                                   graph.getGraphName(),
+                                   graph.getNumberOfNodes() - args.skip_line, // if skip is true, there is no node 0
+                                   graph.getNumberOfEdges(),
+                                   seed_sets[i].size(),
+                                   evaluation.simulations,
+                                   solver_name,
+                                   "$runtime",
+                                   evaluation.forward_influence,
+                                   evaluation.backward_influence,
+                                   reading_time,
+                                   evaluation.cascading_time,
+                                   args.number_of_threads,
+                                   args.diffusion_model);
+
+        // the adaptive evaluation appends the half widths of the confidence intervals
+        if(args.relative_error) {
+            message.pop_back();
+            message = fmt::format("{}\t{}\t{}\n",
+                                  message,
+                                  evaluation.forward_half_width,
+                                  evaluation.backward_half_width);
+        }
+
+        if(args.spread_curve) {
+            message.pop_back();
+            message = fmt::format("{}\t{}\n", message, formatSpreadCurve(evaluation.spread_curve));
+        }
+
+        // in batch mode every row names its seed file
+        if(batch_mode) {
+            message.pop_back();
+            message = fmt::format("{}\t{}\n", message, seed_files[i]);
+        }
+
+        fmt::print("{}", message);
+    }
     std::cout << std::flush;
 }
@@ -3,6 +3,7 @@
 #include <Graph.hpp>
 #include <IMBProgramOptions.hpp>
 #include <Timer.h>
+#include <diffusion/AdaptiveEvaluation.hpp>
 #include <diffusion/DiffusionFactory.hpp>
 #include <diffusion/DiffusionModelInterface.hpp>
 #include <diffusion/IndependentCascade.hpp>
@@ -11,8 +12,22 @@
 #include <fmt/core.h>
 #include <fstream>
 #include <iostream>
+#include <solver/IMM.hpp>
 #include <solver/SolverInterface.hpp>
 
+/**
+ * @return comma separated spread of every seed set prefix
+ */
+inline auto formatSpreadCurve(const std::vector<double>& curve)
+    -> std::string
+{
+    std::string formatted;
+    for(auto spread : curve) {
+        formatted += fmt::format("{}{:.2f}", formatted.empty() ? "" : ",", spread);
+    }
+    return formatted;
+}
+
 class Benchmarker
 {
 public:
@@ -27,7 +42,13 @@ public:
           backwards_activation_(options.shouldPerformBackwardsActivation()),
           reading_time_(file_reading_time),
           threads_(options.getNumberOfThreads()),
-          diffusion_model_(options.getDiffusionModel())
+          diffusion_model_(options.getDiffusionModel()),
+          // one evaluator for all solvers, hence the snapshot model shares its worlds between them
+          diffusion_evaluator_(DiffusionFactory::create(diffusion_model_, graph)),
+          seed_(options.getSeed()),
+          relative_error_(options.getRelativeError()),
+          confidence_(options.getConfidence()),
+          spread_curve_(options.shouldEvaluateSpreadCurve())
     {
 
         if(!raw_output_) {
@@ -55,6 +76,18 @@ public:
                                   message,
                                   reading_time_);
 
+            message = fmt::format("{}Random seed: {}\n",
+                                  message,
+                                  seed_);
+
+            if(relative_error_) {
+                message = fmt::format("{}Adaptive evaluation: relative error {} at {:.1f}% confidence, at most {} simulations\n",
+                                      message,
+                                      relative_error_.value(),
+                                      confidence_ * 100.0,
+                                      reruns_);
+            }
+
             fmt::print("{}", message);
         }
     }
@@ -78,19 +111,29 @@ public:
             writeSeedsTo(path, seeds);
         }
 
-        const auto diffusion_evaluator = DiffusionFactory::create(diffusion_model_, graph_);
+        // IMM keeps its rr sets for later runs, outside of the measured runtime
+        if(auto* imm = dynamic_cast<IMM*>(solver.get()); imm != nullptr and !imm->storeRrSets()) {
+            fmt::print("could not store the rr sets of {}\n", solver_name);
+        }
 
         // cascade_timer
         t.reset();
 
-        double forward_influence = diffusion_evaluator->cascadeForwardN(seeds, reruns_);
-        double backward_influence = -1.0;
+        const auto forward = evaluate(*diffusion_evaluator_, seeds, false);
+        auto backward = InfluenceEstimate{-1.0, 0.0, 0};
 
         if(backwards_activation_) {
-            backward_influence = diffusion_evaluator->cascadeBackwardN(seeds, reruns_);
+            backward = evaluate(*diffusion_evaluator_, seeds, true);
         }
 
         auto cascading_time = t.elapsed();
+        const auto forward_influence = forward.influence;
+        const auto backward_influence = backward.influence;
+
+        // the prefix spreads are not part of the cascading time
+        const auto spread_curve = spread_curve_
+            ? diffusion_evaluator_->cascadeForwardCurveN(seeds, reruns_)
+            : std::vector<double>{};
 
         if(!raw_output_) {
 
@@ -104,6 +147,31 @@ public:
                                   solver_name,
                                   backward_influence);
 
+            if(relative_error_) {
+                message = fmt::format("{}({}) forward {:.1f}% confidence interval: ±{:.2f} ({} simulations)\n",
+                                      message,
+                                      solver_name,
+                                      confidence_ * 100.0,
+                                      forward.half_width,
+                                      forward.simulations);
+                if(backwards_activation_) {
+                    message = fmt::format("{}({}) backward {:.1f}% confidence interval: ±{:.2f} ({} simulations)\n",
+                                          message,
+                                          solver_name,
+                                          confidence_ * 100.0,
+                                          backward.half_width,
+                                          backward.simulations);
+                }
+            }
+
+            if(spread_curve_) {
+                message = fmt::format("{}({}) forward spread of the first 1..{} seeds: {}\n",
+                                      message,
+                                      solver_name,
+                                      spread_curve.size(),
+                                      formatSpreadCurve(spread_curve));
+            }
+
             message = fmt::format("{}({}) cascading time: {:.2f}s\n", message, solver_name, cascading_time);
             message = fmt::format("{}({}) number of threads: {}\n", message, solver_name, threads_);
 
@@ -115,7 +183,7 @@ public:
                                        graph_.getNumberOfNodes(),
                                        graph_.getNumberOfEdges(),
                                        seeds_,
-                                       reruns_,
+                                       forward.simulations,
                                        solver_name,
                                        calculation_time,
                                        forward_influence,
@@ -125,12 +193,49 @@ public:
                                        threads_,
                                        diffusion_model_);
 
+            // the adaptive evaluation appends the half widths of the confidence intervals
+            if(relative_error_) {
+                message.pop_back();
+                message = fmt::format("{}\t{}\t{}\n",
+                                      message,
+                                      forward.half_width,
+                                      backward.half_width);
+            }
+
+            if(spread_curve_) {
+                message.pop_back();
+                message = fmt::format("{}\t{}\n", message, formatSpreadCurve(spread_curve));
+            }
+
             fmt::print("{}", message);
             std::cout << std::flush;
         }
     }
 
 private:
+    /**
+     * evaluates the seeds with a fixed number of simulations,
+     * or adaptively until the requested precision is reached
+     */
+    auto evaluate(const DiffusionModelInterface& model,
+                  const std::vector<NodeId>& seeds,
+                  bool backward) const
+        -> InfluenceEstimate
+    {
+        if(relative_error_) {
+            return estimateInfluence(model,
+                                     seeds,
+                                     backward,
+                                     PrecisionTarget{relative_error_.value(), confidence_, reruns_});
+        }
+
+        // the fixed evaluation does not track the variance, hence there is no interval
+        const auto influence = backward
+            ? model.cascadeBackwardN(seeds, reruns_)
+            : model.cascadeForwardN(seeds, reruns_);
+        return {influence, 0.0, reruns_};
+    }
+
     auto
     createOutPathFor(std::string_view algo_name) const
         -> std::optional<std::string>
@@ -165,7 +270,7 @@ private:
     {
         std::ofstream out_file{path.data()};
         for(auto node : seeds) {
-            out_file << node << "\n";
+            out_file << graph_.getOriginalId(node) << "\n";
         }
     }
 
@@ -178,4 +283,9 @@ private:
     double reading_time_;
     int threads_;
     DiffusionModel diffusion_model_;
+    std::unique_ptr<DiffusionModelInterface> diffusion_evaluator_;
+    std::uint64_t seed_;
+    std::optional<double> relative_error_;
+    double confidence_;
+    bool spread_curve_;
 };
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <Edge.hpp>
+#include <EdgeWeights.hpp>
+#include <cstdint>
+#include <iterator>
+
+/**
+ * Random access iterator over the structure-of-arrays edge storage of the graph.
+ * Dereferencing assembles an Edge value from the destination and the weight model (see EdgeWeights.hpp),
+ * the destination array is either 32 or 64 bit wide (see util::PackedArray).
+ */
+template<class Weights>
+class BasicEdgeIterator
+{
+public:
+    // iterator traits
+    using difference_type = std::ptrdiff_t;
+    using value_type = Edge;
+    using pointer = Edge;
+    using reference = Edge;
+    using iterator_category = std::random_access_iterator_tag;
+
+    BasicEdgeIterator(const std::uint32_t* narrow_destinations,
+                      const std::uint64_t* wide_destinations,
+                      Weights weights,
+                      std::size_t index) noexcept
+        : narrow_destinations_(narrow_destinations),
+          wide_destinations_(wide_destinations),
+          weights_(weights),
+          index_(index) {}
+
+    auto operator*() const noexcept
+        -> Edge
+    {
+        return (*this)[0];
+    }
+
+    auto operator[](difference_type offset) const noexcept
+        -> Edge
+    {
+        auto index = index_ + offset;
+        auto destination = narrow_destinations_ != nullptr
+            ? static_cast<NodeId>(narrow_destinations_[index])
+            : static_cast<NodeId>(wide_destinations_[index]);
+
+        return Edge{destination, weights_(index, destination)};
+    }
+
+    auto operator++() noexcept
+        -> BasicEdgeIterator&
+    {
+        ++index_;
+        return *this;
+    }
+
+    auto operator--() noexcept
+        -> BasicEdgeIterator&
+    {
+        --index_;
+        return *this;
+    }
+
+    auto operator++(int) noexcept
+        -> BasicEdgeIterator
+    {
+        auto ret = *this;
+        ++(*this);
+        return ret;
+    }
+
+    auto operator--(int) noexcept
+        -> BasicEdgeIterator
+    {
+        auto ret = *this;
+        --(*this);
+        return ret;
+    }
+
+    auto operator+=(difference_type offset) noexcept
+        -> BasicEdgeIterator&
+    {
+        index_ += offset;
+        return *this;
+    }
+
+    auto operator-=(difference_type offset) noexcept
+        -> BasicEdgeIterator&
+    {
+        index_ -= offset;
+        return *this;
+    }
+
+    auto operator+(difference_type offset) const noexcept
+        -> BasicEdgeIterator
+    {
+        auto ret = *this;
+        return ret += offset;
+    }
+
+    friend auto operator+(difference_type offset, const BasicEdgeIterator& iter) noexcept
+        -> BasicEdgeIterator
+    {
+        return iter + offset;
+    }
+
+    auto operator-(difference_type offset) const noexcept
+        -> BasicEdgeIterator
+    {
+        auto ret = *this;
+        return ret -= offset;
+    }
+
+    auto operator-(const BasicEdgeIterator& other) const noexcept
+        -> difference_type
+    {
+        return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+    }
+
+    auto operator==(const BasicEdgeIterator& other) const noexcept
+        -> bool
+    {
+        return index_ == other.index_;
+    }
+
+    auto operator!=(const BasicEdgeIterator& other) const noexcept
+        -> bool
+    {
+        return !(*this == other);
+    }
+
+    auto operator<(const BasicEdgeIterator& other) const noexcept
+        -> bool
+    {
+        return index_ < other.index_;
+    }
+
+    auto operator>(const BasicEdgeIterator& other) const noexcept
+        -> bool
+    {
+        return index_ > other.index_;
+    }
+
+    auto operator<=(const BasicEdgeIterator& other) const noexcept
+        -> bool
+    {
+        return index_ <= other.index_;
+    }
+
+    auto operator>=(const BasicEdgeIterator& other) const noexcept
+        -> bool
+    {
+        return index_ >= other.index_;
+    }
+
+private:
+    const std::uint32_t* narrow_destinations_;
+    const std::uint64_t* wide_destinations_;
+    Weights weights_;
+    std::size_t index_;
+};
+
+/**
+ * non owning view of the adjacent edges of a single node
+ */
+template<class Weights>
+class BasicEdgeRange
+{
+public:
+    using Iterator = BasicEdgeIterator<Weights>;
+
+    BasicEdgeRange(Iterator begin, Iterator end) noexcept
+        : begin_(begin),
+          end_(end) {}
+
+    auto begin() const noexcept
+        -> Iterator
+    {
+        return begin_;
+    }
+
+    auto end() const noexcept
+        -> Iterator
+    {
+        return end_;
+    }
+
+    auto operator[](std::size_t index) const noexcept
+        -> Edge
+    {
+        return begin_[static_cast<typename Iterator::difference_type>(index)];
+    }
+
+    auto size() const noexcept
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(end_ - begin_);
+    }
+
+    auto empty() const noexcept
+        -> bool
+    {
+        return begin_ == end_;
+    }
+
+private:
+    Iterator begin_;
+    Iterator end_;
+};
+
+// edges whose weight model is only known at runtime
+using EdgeIterator = BasicEdgeIterator<weights::Dynamic>;
+using EdgeRange = BasicEdgeRange<weights::Dynamic>;
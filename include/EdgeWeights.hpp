@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+using NodeId = std::int_fast64_t;
+
+/**
+ * how the weights (activation probabilities) of one edge direction are stored.
+ * Only explicit weights need one float per edge, the other models derive the weight from a node or a 2 bit class
+ */
+enum class WeightLayout : std::uint8_t {
+    // no weights are known yet, every weight is NaN
+    UNKNOWN = 0,
+    // one float per edge
+    EXPLICIT = 1,
+    // one float per node, the weight of an edge is the value of its destination (weighted cascade, forward edges)
+    PER_DESTINATION = 2,
+    // one float per node, the weight of an edge is the value of the node it belongs to (weighted cascade, backward edges)
+    PER_SOURCE = 3,
+    // one probability for all edges
+    UNIFORM = 4,
+    // one of {0.1, 0.01, 0.001} per edge, stored as 2 bit class ids
+    TRIVALENCY = 5
+};
+
+/**
+ * the weight models as function objects weight(edge index, destination).
+ * Kernels which are instantiated for a concrete model (see Graph::visitEdges) compute the weights without branching,
+ * Dynamic dispatches on the layout for every edge
+ */
+namespace weights {
+
+constexpr std::array<float, 4> TRIVALENCY_PROBABILITIES = {0.1f, 0.01f, 0.001f, 0.0f};
+
+// 2 bit classes, four edges per byte
+constexpr std::size_t CLASSES_PER_BYTE = 4;
+
+inline auto trivalencyClassOf(const std::uint8_t* classes, std::size_t edge) noexcept
+    -> std::uint8_t
+{
+    return (classes[edge / CLASSES_PER_BYTE] >> (edge % CLASSES_PER_BYTE * 2)) & 0b11u;
+}
+
+struct Explicit
+{
+    const float* values;
+
+    auto operator()(std::size_t edge, NodeId /* destination */) const noexcept
+        -> float
+    {
+        return values[edge];
+    }
+};
+
+struct PerDestination
+{
+    const float* node_values;
+
+    auto operator()(std::size_t /* edge */, NodeId destination) const noexcept
+        -> float
+    {
+        return node_values[destination];
+    }
+};
+
+/**
+ * uniform weights and the per source weights of the edges of a single node
+ */
+struct Constant
+{
+    float value;
+
+    auto operator()(std::size_t /* edge */, NodeId /* destination */) const noexcept
+        -> float
+    {
+        return value;
+    }
+};
+
+struct Trivalency
+{
+    const std::uint8_t* classes;
+
+    auto operator()(std::size_t edge, NodeId /* destination */) const noexcept
+        -> float
+    {
+        return TRIVALENCY_PROBABILITIES[trivalencyClassOf(classes, edge)];
+    }
+};
+
+struct Dynamic
+{
+    WeightLayout layout;
+    // per edge or per node values
+    const float* values;
+    const std::uint8_t* classes;
+    // uniform probability or the per source value of the node
+    float value;
+
+    auto operator()(std::size_t edge, NodeId destination) const noexcept
+        -> float
+    {
+        switch(layout) {
+        case WeightLayout::EXPLICIT:
+            return values[edge];
+        case WeightLayout::PER_DESTINATION:
+            return values[destination];
+        case WeightLayout::PER_SOURCE:
+        case WeightLayout::UNIFORM:
+            return value;
+        case WeightLayout::TRIVALENCY:
+            return TRIVALENCY_PROBABILITIES[trivalencyClassOf(classes, edge)];
+        default:
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+};
+
+} // namespace weights
@@ -1,14 +1,45 @@
 #pragma once
 
 #include <Edge.hpp>
+#include <EdgeRange.hpp>
+#include <EdgeWeights.hpp>
 #include <cstdint>
-#include <dSFMT.h>
-#include <nonstd/span.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <util/Buffer.hpp>
+#include <util/MemoryMap.hpp>
+#include <util/PackedArray.hpp>
+#include <util/Random.hpp>
 #include <util/Range.hpp>
 #include <vector>
 
 using NodeId = std::int_fast64_t;
 
+/**
+ * translates the ids of the input file to internal ids, see Graph::getInternalIds.
+ * Refers to the original ids of the graph, hence the graph has to outlive it
+ */
+class InternalIds
+{
+public:
+    /**
+     * @return internal id of the node with the given id in the input file, nullopt if the graph has no such node
+     */
+    auto find(NodeId original_id) const noexcept
+        -> std::optional<NodeId>;
+
+private:
+    friend class Graph;
+
+    NodeId number_of_nodes_ = 0;
+    // original id of every node, empty if the ids are the internal ids
+    std::span<const std::uint64_t> original_ids_;
+    // internal ids ordered by their original id, empty if the original ids are already sorted
+    std::vector<NodeId> by_original_id_;
+};
+
 class Graph
 {
 public:
@@ -20,10 +51,38 @@ public:
     auto operator=(const Graph&) -> Graph& = default;
 
     auto getEdgesOf(NodeId node) const
-        -> nonstd::span<const Edge>;
+        -> EdgeRange;
 
     auto getInverseEdgesOf(NodeId node) const
-        -> nonstd::span<const Edge>;
+        -> EdgeRange;
+
+    /**
+     * calls kernel(edges_of), where edges_of(node) returns the edges (inverse edges if backward is set) of the node.
+     * The weights of these edge ranges are computed by a type specialized for the weight model of the graph,
+     * hence the kernel is instantiated once per model and its loops do not branch on the model for every edge
+     */
+    template<class Kernel>
+    auto visitEdges(bool backward, Kernel&& kernel) const
+        -> decltype(auto)
+    {
+        if(backward) {
+            return backward_.visit(kernel);
+        }
+        return forward_.visit(kernel);
+    }
+
+    /**
+     * @return index of the first edge of the node, the edges of the graph are numbered 0..|E|-1
+     * and the i-th edge of getEdgesOf(node) has the index getEdgeOffsetOf(node) + i
+     */
+    auto getEdgeOffsetOf(NodeId node) const noexcept
+        -> std::size_t;
+
+    /**
+     * @return index of the first inverse edge of the node (see getEdgeOffsetOf)
+     */
+    auto getInverseEdgeOffsetOf(NodeId node) const noexcept
+        -> std::size_t;
 
     auto getOutDegreeOf(NodeId node) const
         -> std::int64_t;
@@ -46,16 +105,169 @@ public:
     auto getNodes() const
         -> utils::impl::RangeWrapper<std::int64_t, true>;
 
+    /**
+     * assigns the weighted cascade weights 1 / in-degree(destination) to all edges without a weight,
+     * they are derived from one value per node instead of being stored per edge
+     */
     auto calculateEdgeWeights() -> void;
 
-    auto getRandomNode() const noexcept
+    /**
+     * assigns the same activation probability to all edges
+     */
+    auto setUniformEdgeWeights(float probability)
+        -> void;
+
+    auto getRandomNode(util::RandomGenerator& generator) const noexcept
         -> NodeId;
 
+    /**
+     * @return hash of the offsets and the weight model of one edge direction, which identifies the graph
+     * without reading every edge (explicit weights of the graph file are not hashed, random trivalency classes are)
+     */
+    auto getFingerprint(bool backward) const noexcept
+        -> std::uint64_t;
+
+    /**
+     * @return true if node ids and edge offsets are stored with 32 bits
+     */
+    auto usesCompactStorage() const noexcept
+        -> bool;
+
+    /**
+     * @return id of the node in the input file, differs from the internal id if the ids were relabeled during parsing
+     */
+    auto getOriginalId(NodeId node) const noexcept
+        -> NodeId;
+
+    /**
+     * @return internal id of the node with the given id in the input file, nullopt if the graph has no such node.
+     * Scans all nodes if the ids were relabeled or permuted, use getInternalIds to translate many ids
+     */
+    auto getInternalId(NodeId original_id) const noexcept
+        -> std::optional<NodeId>;
+
+    /**
+     * @return translation of the ids of the input file to the internal ids of all nodes.
+     * Needs no additional memory unless the graph was permuted
+     */
+    auto getInternalIds() const
+        -> InternalIds;
+
+    /**
+     * renumbers the nodes, the node order[i] of the current graph becomes node i.
+     * Both edge directions are rebuild, the original ids are kept (see getOriginalId)
+     * @param order permutation of all node ids
+     */
+    auto permute(const std::vector<NodeId>& order)
+        -> void;
+
 private:
+    /**
+     * one edge direction in CSR layout.
+     * Destinations and weights are stored in separate arrays (structure of arrays),
+     * destinations and offsets use 32 bit entries whenever the graph fits.
+     */
+    struct EdgeStorage
+    {
+        util::PackedArray offsets;
+        util::PackedArray destinations;
+        WeightLayout weight_layout = WeightLayout::UNKNOWN;
+        // one value per edge (EXPLICIT) or per node (PER_DESTINATION, PER_SOURCE)
+        util::Buffer<float> weights;
+        // 2 bit class per edge (TRIVALENCY)
+        util::Buffer<std::uint8_t> weight_classes;
+        // probability of every edge (UNIFORM)
+        float uniform_weight = 0.0f;
+
+        auto edgesOf(NodeId node) const noexcept
+            -> EdgeRange;
+
+        template<class Weights>
+        auto edgesOf(NodeId node, Weights edge_weights) const noexcept
+            -> BasicEdgeRange<Weights>
+        {
+            const auto start_offset = offsets.get(node);
+            const auto end_offset = offsets.get(node + 1);
+            const auto* narrow = destinations.narrowData();
+            const auto* wide = destinations.wideData();
+
+            return {BasicEdgeIterator<Weights>{narrow, wide, edge_weights, start_offset},
+                    BasicEdgeIterator<Weights>{narrow, wide, edge_weights, end_offset}};
+        }
+
+        /**
+         * see Graph::visitEdges
+         */
+        template<class Kernel>
+        auto visit(Kernel&& kernel) const
+            -> decltype(auto)
+        {
+            switch(weight_layout) {
+            case WeightLayout::EXPLICIT:
+                return kernel([this](NodeId node) {
+                    return edgesOf(node, weights::Explicit{weights.data()});
+                });
+            case WeightLayout::PER_DESTINATION:
+                return kernel([this](NodeId node) {
+                    return edgesOf(node, weights::PerDestination{weights.data()});
+                });
+            case WeightLayout::PER_SOURCE:
+                return kernel([this](NodeId node) {
+                    return edgesOf(node, weights::Constant{weights[node]});
+                });
+            case WeightLayout::UNIFORM:
+                return kernel([this](NodeId node) {
+                    return edgesOf(node, weights::Constant{uniform_weight});
+                });
+            case WeightLayout::TRIVALENCY:
+                return kernel([this](NodeId node) {
+                    return edgesOf(node, weights::Trivalency{weight_classes.data()});
+                });
+            default:
+                return kernel([this](NodeId node) {
+                    return edgesOf(node);
+                });
+            }
+        }
+
+        /**
+         * sets the trivalency class of an edge, edges sharing a byte may be set concurrently
+         */
+        auto setWeightClass(std::size_t edge, std::uint8_t weight_class) noexcept
+            -> void;
+
+        /**
+         * @return trivalency class of an edge, safe while edges sharing its byte are set concurrently
+         */
+        auto weightClassOf(std::size_t edge) noexcept
+            -> std::uint8_t;
+
+        /**
+         * assigns one of the trivalency probabilities to every edge at random
+         */
+        auto assignRandomWeightClasses()
+            -> void;
+
+        /**
+         * sorts the edges of every node by their destination id (in parallel)
+         */
+        auto sortAdjacencies()
+            -> void;
+
+        /**
+         * @return edge storage of the graph with node order[i] renamed to i
+         * @param rank inverse permutation of order
+         */
+        auto permuted(const std::vector<NodeId>& order,
+                      const std::vector<NodeId>& rank) const
+            -> EdgeStorage;
+    };
+
     friend auto parseVertexListFile(std::string_view path,
                                     bool inverse,
                                     bool contains_meta_data,
                                     bool random_edge_weights,
+                                    bool relabel_ids,
                                     bool should_log)
         -> Graph;
 
@@ -63,26 +275,39 @@ private:
                                   bool inverse,
                                   bool contains_meta_data,
                                   bool random_edge_weights,
+                                  bool relabel_ids,
                                   bool should_log)
         -> Graph;
 
+    friend auto parseBinaryFile(std::string_view path,
+                                bool inverse,
+                                bool random_edge_weights,
+                                bool should_log)
+        -> Graph;
+
+    friend auto writeBinaryFile(const Graph& graph,
+                                std::string_view path,
+                                bool inverse,
+                                bool random_edge_weights)
+        -> bool;
+
     /**
-     * THIS IS NOT A NORMAL ADD_NODE METHOD
-     *
-     * id muss be current_max_id + 1
-     * otherwise everything goes to shit
-     * don't use this method unless you are sure what you do
-     *
-     *
-     * @param node next node with index: current_max_index + 1
-     * @param edges adjacent edges
+     * builds the forward CSR arrays from flat edge arrays with a parallel counting sort by source
+     * @param sources source of every edge
+     * @param destinations destination of every edge
+     * @param weights weight of every edge, if empty all weights are unknown (NaN)
+     * @param number_of_nodes all ids need to be smaller
      */
-    auto appendNode(NodeId node, std::vector<Edge> edges)
+    auto buildForwardEdges(const util::PackedArray& sources,
+                           const util::PackedArray& destinations,
+                           const util::Buffer<float>& weights,
+                           std::size_t number_of_nodes)
         -> void;
 
     /**
 	 * This method needs to be called on a fully build graph in order
-	 * have the backward edges available
+	 * have the backward edges available.
+	 * It also selects the compact (32 bit) storage for the forward edges if possible.
 	 */
     auto calculateBackwardEdges()
         -> void;
@@ -94,11 +319,12 @@ private:
         -> void;
 
 
-    mutable dsfmt_t dsfmt_;
-    std::vector<std::size_t> forward_offset_array_;
-    std::vector<std::size_t> backward_offset_array_;
-    std::vector<Edge> forward_edges_;
-    std::vector<Edge> backward_edges_;
+    EdgeStorage forward_;
+    EdgeStorage backward_;
+    // original id of every node, empty if the ids were neither relabeled nor permuted
+    util::Buffer<std::uint64_t> original_ids_;
+    // keeps the arrays of graphs loaded from a binary file alive
+    std::unique_ptr<util::MemoryMap> mapping_;
     // todo store during parsing
     std::string graph_name_;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Parser.hpp>
+#include <Reordering.hpp>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -22,7 +23,16 @@ public:
                       bool use_inverse_graph,
                       bool backwards_activation,
                       bool random_edge_weights,
+                      std::optional<float> uniform_probability,
+                      bool relabel_ids,
+                      ReorderStrategy reorder_strategy,
+                      std::uint64_t seed,
+                      std::optional<double> relative_error,
+                      double confidence,
+                      bool spread_curve,
+                      std::optional<std::string> rr_set_path,
                       std::optional<std::string> out_path,
+                      std::optional<std::string> binary_out_path,
                       std::vector<std::string> solver);
     IMBProgramOptions() = delete;
     IMBProgramOptions(const IMBProgramOptions&) = delete;
@@ -58,6 +68,12 @@ public:
     auto getSolvers() const
         -> const std::vector<std::string>&;
 
+    /**
+     * @return path to which the loaded graph should be written as binary graph file (converter mode)
+     */
+    auto getBinaryOutPath() const
+        -> const std::optional<std::string>&;
+
     auto shouldUseInverseGraph() const
         -> bool;
 
@@ -67,6 +83,51 @@ public:
     auto shouldUseRandomEdgeWeights() const
         -> bool;
 
+    /**
+     * @return activation probability of all edges, if set it replaces the weights of the graph
+     */
+    auto getUniformProbability() const
+        -> const std::optional<float>&;
+
+    /**
+     * @return true if sparse node ids of the input file should be compacted to 0..n-1
+     */
+    auto shouldRelabelIds() const
+        -> bool;
+
+    auto getReorderStrategy() const
+        -> ReorderStrategy;
+
+    /**
+     * @return seed of the random number generators, either given with --seed or chosen randomly
+     */
+    auto getSeed() const
+        -> std::uint64_t;
+
+    /**
+     * @return relative error the evaluation has to reach, if set the simulations (reruns) are only the budget
+     */
+    auto getRelativeError() const
+        -> const std::optional<double>&;
+
+    /**
+     * @return confidence level of the relative error
+     */
+    auto getConfidence() const
+        -> double;
+
+    /**
+     * @return true if the spread of every prefix of the seed sets should be reported
+     */
+    auto shouldEvaluateSpreadCurve() const
+        -> bool;
+
+    /**
+     * @return file in which IMM keeps its rr sets between runs
+     */
+    auto getRrSetPath() const
+        -> const std::optional<std::string>&;
+
     auto getDiffusionModel() const
         -> DiffusionModel;
 
@@ -81,7 +142,16 @@ private:
     bool use_inverse_graph_;
     bool backwards_activation_;
     bool random_edge_weights_;
+    std::optional<float> uniform_probability_;
+    bool relabel_ids_;
+    ReorderStrategy reorder_strategy_;
+    std::uint64_t seed_;
+    std::optional<double> relative_error_;
+    double confidence_;
+    bool spread_curve_;
+    std::optional<std::string> rr_set_path_;
     std::optional<std::string> out_path_;
+    std::optional<std::string> binary_out_path_;
     std::vector<std::string> solver_;
 };
 
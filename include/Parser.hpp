@@ -5,7 +5,8 @@
 
 enum class ParseMode : std::size_t {
     VERTEX_LIST = 0,
-    EDGE_LIST = 1
+    EDGE_LIST = 1,
+    BINARY = 2
 };
 
 /**
@@ -14,6 +15,8 @@ enum class ParseMode : std::size_t {
  * @param inverse if true, the edge directions are inverse
  * @param contains_meta_data if true, the first line (not containing starting with a comment sign) is skipped
  * @param random_edge_weights if true, the weights of the edges are randomly choosen from {0.1, 0.01, 0.001}
+ * @param relabel_ids if true, the first id of every line identifies the node instead of the line number
+ *        and all ids are compacted to 0..n-1, the original ids are kept in the graph (see Graph::getOriginalId)
  * @param should_log if true, some information is printed during the parsing process
  * @return graph
  */
@@ -21,6 +24,7 @@ auto parseVertexListFile(std::string_view path,
                          bool inverse,
                          bool contains_meta_data,
                          bool random_edge_weights,
+                         bool relabel_ids,
                          bool should_log)
     -> Graph;
 
@@ -30,6 +34,8 @@ auto parseVertexListFile(std::string_view path,
  * @param inverse if true, the edge directions are inverse
  * @param contains_meta_data if true, the first line (not containing starting with a comment sign) is skipped
  * @param random_edge_weights if true, the weights of the edges are randomly choosen from {0.1, 0.01, 0.001}
+ * @param relabel_ids if true, the (possibly sparse) ids are compacted to 0..n-1,
+ *        the original ids are kept in the graph (see Graph::getOriginalId)
  * @param should_log if true, some information is printed during the parsing process
  * @return graph
  */
@@ -37,5 +43,36 @@ auto parseEdgeListFile(std::string_view path,
                        bool inverse,
                        bool contains_meta_data,
                        bool random_edge_weights,
+                       bool relabel_ids,
                        bool should_log)
     -> Graph;
+
+/**
+ * maps a binary graph file (written by writeBinaryFile) read-only into memory.
+ * The arrays of the graph point directly into the mapping, hence loading is independent of the graph size
+ * and the page cache is shared between all processes using the same file.
+ * @param path path to the binary graph file
+ * @param inverse expected inverse flag, the program exits if the file was written with a different one
+ * @param random_edge_weights expected weight model, the program exits if the file was written with a different one
+ * @param should_log if true, some information is printed during the loading process
+ * @return graph
+ */
+auto parseBinaryFile(std::string_view path,
+                     bool inverse,
+                     bool random_edge_weights,
+                     bool should_log)
+    -> Graph;
+
+/**
+ * writes the CSR arrays (offsets, destinations and weights) of both edge directions into a binary graph file
+ * @param graph fully loaded graph
+ * @param path output path
+ * @param inverse if true, the graph was loaded with inverse edge directions
+ * @param random_edge_weights if true, the graph was loaded with random edge weights
+ * @return true if the file was written successfully
+ */
+auto writeBinaryFile(const Graph& graph,
+                     std::string_view path,
+                     bool inverse,
+                     bool random_edge_weights)
+    -> bool;
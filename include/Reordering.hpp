@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <vector>
+
+/**
+ * node orders which place nodes that are accessed together close to each other in memory.
+ * Solvers and diffusion models access per node arrays with the ids of the neighbours,
+ * on power law graphs a good order turns most of these random accesses into cache hits.
+ */
+enum class ReorderStrategy : std::size_t {
+    NONE = 0,
+    DEGREE = 1,
+    RCM = 2,
+    COMMUNITY = 3
+};
+
+/**
+ * nodes sorted by their degree (in + out) in descending order, the hubs share the first cache lines
+ * @return order[i] is the node which becomes node i
+ */
+auto computeDegreeOrder(const Graph& graph)
+    -> std::vector<NodeId>;
+
+/**
+ * reverse Cuthill-McKee order of the undirected graph,
+ * a breadth first search which visits the neighbours of every node by ascending degree
+ * @return order[i] is the node which becomes node i
+ */
+auto computeRcmOrder(const Graph& graph)
+    -> std::vector<NodeId>;
+
+/**
+ * community order: communities are detected with label propagation on the undirected graph,
+ * afterwards the nodes of every community are placed next to each other (similar to rabbit order)
+ * @return order[i] is the node which becomes node i
+ */
+auto computeCommunityOrder(const Graph& graph)
+    -> std::vector<NodeId>;
+
+/**
+ * permutes the nodes of the graph according to the given strategy, does nothing for ReorderStrategy::NONE.
+ * The ids of the input file are kept, seeds have to be written with Graph::getOriginalId
+ * @param should_log if true, the time needed for the reordering is printed
+ */
+auto reorderGraph(Graph& graph,
+                  ReorderStrategy strategy,
+                  bool should_log)
+    -> void;
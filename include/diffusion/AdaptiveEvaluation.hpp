@@ -0,0 +1,36 @@
+#pragma once
+
+#include <diffusion/DiffusionModelInterface.hpp>
+#include <vector>
+
+/**
+ * precision an adaptive evaluation has to reach
+ */
+struct PrecisionTarget
+{
+    // half width of the confidence interval relative to the estimated influence
+    double relative_error;
+    // confidence level of the interval, e.g. 0.95
+    double confidence;
+    // the evaluation stops after this many simulations, even if the precision was not reached
+    std::size_t max_simulations;
+};
+
+struct InfluenceEstimate
+{
+    double influence;
+    // half width of the confidence interval around the influence
+    double half_width;
+    std::size_t simulations;
+};
+
+/**
+ * runs simulations in parallel batches until the confidence interval of the mean influence
+ * is narrow enough or the budget is exhausted.
+ * The batch sizes are predicted from the variance observed so far
+ */
+auto estimateInfluence(const DiffusionModelInterface& model,
+                       const std::vector<NodeId>& seeds,
+                       bool backward,
+                       const PrecisionTarget& target) noexcept
+    -> InfluenceEstimate;
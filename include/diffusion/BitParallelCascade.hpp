@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <diffusion/DiffusionModelInterface.hpp>
+#include <util/Random.hpp>
+
+/**
+ * independent cascade model which runs 64 simulations (worlds) at once.
+ * Every node carries a bit mask of the worlds in which it is active,
+ * an edge draws one mask of the worlds in which it is live and propagation is an OR over masks.
+ * The results are statistically equivalent to IndependentCascader.
+ */
+class BitParallelCascader final : public DiffusionModelInterface
+{
+public:
+    BitParallelCascader(const Graph& graph) noexcept;
+
+    auto cascadeForwardN(const std::vector<NodeId>& seeds,
+                         std::size_t n) const noexcept
+        -> double final;
+
+    auto cascadeBackwardN(const std::vector<NodeId>& seeds,
+                          std::size_t n) const noexcept
+        -> double final;
+
+    auto sampleForwardN(const std::vector<NodeId>& seeds,
+                        std::size_t n) const noexcept
+        -> util::RunningStatistics final;
+
+    auto sampleBackwardN(const std::vector<NodeId>& seeds,
+                         std::size_t n) const noexcept
+        -> util::RunningStatistics final;
+
+    auto cascadeForwardCurveN(const std::vector<NodeId>& seeds,
+                              std::size_t n) const noexcept
+        -> std::vector<double> final;
+
+private:
+    /**
+     * runs the simulations of the worlds in the given mask,
+     * the activated nodes of every world are added to per_world if it is given
+     * @return sum of the activated nodes over all worlds
+     */
+    auto cascadeWorlds(const std::vector<NodeId>& seeds,
+                       std::uint64_t worlds,
+                       bool backward,
+                       util::RandomGenerator& generator,
+                       util::RunningStatistics* per_world = nullptr) const noexcept
+        -> std::size_t;
+
+    auto cascadeN(const std::vector<NodeId>& seeds,
+                  std::size_t n,
+                  bool backward) const noexcept
+        -> double;
+
+    auto sampleN(const std::vector<NodeId>& seeds,
+                 std::size_t n,
+                 bool backward) const noexcept
+        -> util::RunningStatistics;
+
+    const Graph& graph_;
+};
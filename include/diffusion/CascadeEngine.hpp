@@ -0,0 +1,167 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <diffusion/DiffusionModelInterface.hpp>
+#include <execution>
+#include <util/Random.hpp>
+#include <util/SimulationScratch.hpp>
+
+/**
+ * monte carlo evaluation of a diffusion model, which only has to describe how a cascade spreads.
+ * The model is a policy with a method
+ *     template<bool Backward, class Scratch, class EdgesOf>
+ *     spread(Scratch& scratch, const EdgesOf& edges_of, util::RandomGenerator& generator)
+ * that activates everything the nodes in the work queue of the scratch reach.
+ * edges_of(node) returns the edges of the node in the given direction with the weight model of the graph,
+ * it is chosen once per evaluation (see Graph::visitEdges), hence direction, weight model and
+ * visited set (Scratch) are compile time parameters of the inner loops of the model
+ */
+template<class Model, class Scratch = util::SimulationScratch>
+class CascadeEngine final : public DiffusionModelInterface
+{
+public:
+    CascadeEngine(const Graph& graph) noexcept
+        : graph_(graph),
+          model_(graph) {}
+
+    auto cascadeForwardN(const std::vector<NodeId>& seeds,
+                         std::size_t n) const noexcept
+        -> double final
+    {
+        return averageN<false>(seeds, n);
+    }
+
+    auto cascadeBackwardN(const std::vector<NodeId>& seeds,
+                          std::size_t n) const noexcept
+        -> double final
+    {
+        return averageN<true>(seeds, n);
+    }
+
+    auto sampleForwardN(const std::vector<NodeId>& seeds,
+                        std::size_t n) const noexcept
+        -> util::RunningStatistics final
+    {
+        return sampleN<false>(seeds, n);
+    }
+
+    auto sampleBackwardN(const std::vector<NodeId>& seeds,
+                         std::size_t n) const noexcept
+        -> util::RunningStatistics final
+    {
+        return sampleN<true>(seeds, n);
+    }
+
+    auto cascadeForwardCurveN(const std::vector<NodeId>& seeds,
+                              std::size_t n) const noexcept
+        -> std::vector<double> final
+    {
+        return graph_.visitEdges(false, [&](auto edges_of) {
+            const auto family = util::RandomService::newStreamFamily();
+            const auto simulations = utils::range(n);
+
+            return std::transform_reduce(
+                std::execution::par,
+                std::begin(simulations),
+                std::end(simulations),
+                std::vector<double>(seeds.size(), 0.0),
+                [](auto acc, const auto& current) {
+                    std::transform(std::begin(acc), std::end(acc), std::begin(current), std::begin(acc), std::plus<>{});
+                    return acc;
+                },
+                [&](auto simulation) {
+                    auto generator = util::RandomService::stream(family, simulation);
+                    auto& scratch = Scratch::local(graph_.getNumberOfNodes());
+
+                    // the cascade of the first k seeds is extended by the (k+1)-th seed
+                    std::vector<double> curve(seeds.size());
+                    for(std::size_t k = 0; k < seeds.size(); ++k) {
+                        if(scratch.activate(seeds[k])) {
+                            scratch.workQueue().emplace_back(seeds[k]);
+                        }
+                        model_.template spread<false>(scratch, edges_of, generator);
+                        curve[k] = scratch.activatedNodes().size() / static_cast<double>(n);
+                    }
+                    return curve;
+                });
+        });
+    }
+
+private:
+    /**
+     * @return number of nodes activated by the seeds in one simulation
+     */
+    template<bool Backward, class EdgesOf>
+    auto cascade(const std::vector<NodeId>& seeds,
+                 const EdgesOf& edges_of,
+                 util::RandomGenerator& generator) const noexcept
+        -> std::size_t
+    {
+        auto& scratch = Scratch::local(graph_.getNumberOfNodes());
+        auto& work_queue = scratch.workQueue();
+
+        for(auto n : seeds) {
+            if(scratch.activate(n)) {
+                work_queue.emplace_back(n);
+            }
+        }
+
+        model_.template spread<Backward>(scratch, edges_of, generator);
+
+        return scratch.activatedNodes().size();
+    }
+
+    template<bool Backward>
+    auto averageN(const std::vector<NodeId>& seeds, std::size_t n) const noexcept
+        -> double
+    {
+        return graph_.visitEdges(Backward, [&](auto edges_of) {
+            const auto family = util::RandomService::newStreamFamily();
+            const auto simulations = utils::range(n);
+
+            return std::transform_reduce(
+                std::execution::par,
+                std::begin(simulations),
+                std::end(simulations),
+                0.0,
+                [](auto acc, auto current) {
+                    return acc + current;
+                },
+                [&](auto simulation) {
+                    // every MC run uses its own random stream
+                    auto generator = util::RandomService::stream(family, simulation);
+                    return cascade<Backward>(seeds, edges_of, generator)
+                        / static_cast<double>(n);
+                });
+        });
+    }
+
+    template<bool Backward>
+    auto sampleN(const std::vector<NodeId>& seeds, std::size_t n) const noexcept
+        -> util::RunningStatistics
+    {
+        return graph_.visitEdges(Backward, [&](auto edges_of) {
+            const auto family = util::RandomService::newStreamFamily();
+            const auto simulations = utils::range(n);
+
+            return std::transform_reduce(
+                std::execution::par,
+                std::begin(simulations),
+                std::end(simulations),
+                util::RunningStatistics{},
+                [](auto acc, const auto& current) {
+                    acc.merge(current);
+                    return acc;
+                },
+                [&](auto simulation) {
+                    auto generator = util::RandomService::stream(family, simulation);
+                    util::RunningStatistics statistics;
+                    statistics.add(static_cast<double>(cascade<Backward>(seeds, edges_of, generator)));
+                    return statistics;
+                });
+        });
+    }
+
+    const Graph& graph_;
+    const Model model_;
+};
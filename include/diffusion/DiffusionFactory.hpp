@@ -2,21 +2,31 @@
 #pragma once
 
 #include <IMBProgramOptions.hpp>
+#include <diffusion/BitParallelCascade.hpp>
 #include <diffusion/DiffusionModelInterface.hpp>
 #include <diffusion/IndependentCascade.hpp>
 #include <diffusion/LinearThreshold.hpp>
+#include <diffusion/SnapshotCascade.hpp>
 
 class DiffusionFactory
 {
 public:
+    /**
+     * the monte carlo models are instantiations of CascadeEngine,
+     * the virtual interface is only crossed once per evaluation
+     */
     static auto create(DiffusionModel type, const Graph& graph) noexcept
         -> std::unique_ptr<DiffusionModelInterface>
     {
         switch(type) {
         case DiffusionModel::LINEAR_THRESHOLD:
-            return std::make_unique<LinearThresholdEvaluation>(graph);
+            return std::make_unique<CascadeEngine<LinearThresholdModel>>(graph);
         case DiffusionModel::INDEPENDENT_CASCADE:
-            return std::make_unique<IndependentCascader>(graph);
+            return std::make_unique<CascadeEngine<IndependentCascadeModel>>(graph);
+        case DiffusionModel::INDEPENDENT_CASCADE_BIT_PARALLEL:
+            return std::make_unique<BitParallelCascader>(graph);
+        case DiffusionModel::INDEPENDENT_CASCADE_SNAPSHOTS:
+            return std::make_unique<SnapshotCascader>(graph);
         default:
             return nullptr;
         }
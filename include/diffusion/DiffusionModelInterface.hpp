@@ -1,7 +1,7 @@
-
 #pragma once
 
 #include <Edge.hpp>
+#include <util/RunningStatistics.hpp>
 #include <vector>
 
 class DiffusionModelInterface
@@ -16,5 +16,25 @@ public:
                                   std::size_t n) const noexcept
         -> double = 0;
 
+    /**
+     * runs n simulations like cascadeForwardN, but keeps the variance of the number of activated nodes
+     */
+    virtual auto sampleForwardN(const std::vector<NodeId>& seeds,
+                                std::size_t n) const noexcept
+        -> util::RunningStatistics = 0;
+
+    virtual auto sampleBackwardN(const std::vector<NodeId>& seeds,
+                                 std::size_t n) const noexcept
+        -> util::RunningStatistics = 0;
+
+    /**
+     * adds the seeds in the given order to every simulated world and extends its cascade,
+     * hence the spread of every prefix costs about as much as the spread of all seeds
+     * @return average number of forward activated nodes of the first k seeds at index k-1
+     */
+    virtual auto cascadeForwardCurveN(const std::vector<NodeId>& seeds,
+                                      std::size_t n) const noexcept
+        -> std::vector<double> = 0;
+
     virtual ~DiffusionModelInterface() = default;
 };
@@ -1,30 +1,75 @@
 #pragma once
 
 #include <Graph.hpp>
-#include <dSFMT.h>
-#include <diffusion/DiffusionModelInterface.hpp>
+#include <diffusion/CascadeEngine.hpp>
+#include <diffusion/LiveEdgeSampler.hpp>
+#include <mutex>
+#include <optional>
+#include <tbb/task_arena.h>
 
-class IndependentCascader final : public DiffusionModelInterface
+/**
+ * independent cascade model: every newly activated node gets one chance to activate each of its neighbours
+ * with the probability of the edge (policy of CascadeEngine)
+ */
+class IndependentCascadeModel
 {
 public:
-    IndependentCascader(const Graph& graph) noexcept;
+    IndependentCascadeModel(const Graph& graph);
 
+    /**
+     * activates everything the nodes in the work queue of the scratch reach
+     */
+    template<bool Backward, class Scratch, class EdgesOf>
+    auto spread(Scratch& scratch,
+                const EdgesOf& edges_of,
+                util::RandomGenerator& generator) const noexcept
+        -> void
+    {
+        const auto& sampler = samplerOf<Backward>();
+        auto& work_queue = scratch.workQueue();
 
-    auto cascadeForwardN(const std::vector<NodeId>& seeds,
-                         std::size_t n) const noexcept
-        -> double final;
+        while(!work_queue.empty()) {
+            auto current = work_queue.back();
+            work_queue.pop_back();
 
-
-    auto cascadeBackwardN(const std::vector<NodeId>& seeds,
-                          std::size_t n) const noexcept
-        -> double final;
+            sampler.forEachLiveEdge(
+                current,
+                edges_of,
+                generator,
+                [&](auto destination) { return !scratch.isActivated(destination); },
+                [&](auto destination) {
+                    scratch.activate(destination);
+                    work_queue.emplace_back(destination);
+                });
+        }
+    }
 
 private:
-    auto cascadeForward(std::vector<NodeId> seeds, dsfmt_t dsfmt) const noexcept
-        -> std::size_t;
-
-    auto cascadeBackward(std::vector<NodeId> seeds, dsfmt_t dsfmt) const noexcept
-        -> std::size_t;
+    /**
+     * builds the sampler of a direction on its first use, most runs only spread in one direction
+     */
+    template<bool Backward>
+    auto samplerOf() const noexcept
+        -> const LiveEdgeSampler&
+    {
+        auto& sampler = Backward ? backward_edges_ : forward_edges_;
+        // the construction is parallel, the isolation keeps the thread from entering call_once again meanwhile
+        std::call_once(Backward ? backward_once_ : forward_once_, [&] {
+            tbb::this_task_arena::isolate([&] {
+                sampler.emplace(graph_, Backward);
+            });
+        });
+        return sampler.value();
+    }
 
     const Graph& graph_;
+    mutable std::once_flag forward_once_;
+    mutable std::once_flag backward_once_;
+    mutable std::optional<LiveEdgeSampler> forward_edges_;
+    mutable std::optional<LiveEdgeSampler> backward_edges_;
 };
+
+using IndependentCascader = CascadeEngine<IndependentCascadeModel>;
+
+// instantiated once in IndependentCascade.cpp
+extern template class CascadeEngine<IndependentCascadeModel>;
@@ -1,31 +1,55 @@
 #pragma once
 
 #include <Graph.hpp>
-#include <diffusion/DiffusionModelInterface.hpp>
-#include <dSFMT.h>
+#include <diffusion/CascadeEngine.hpp>
 
-class LinearThresholdEvaluation final : public DiffusionModelInterface
+/**
+ * linear threshold model: every node draws a random threshold and is activated as soon as
+ * the weights of the edges from its active neighbours sum up to it (policy of CascadeEngine)
+ */
+class LinearThresholdModel
 {
-
 public:
-    LinearThresholdEvaluation(const Graph& graph) noexcept;
-
-
-    auto cascadeForwardN(const std::vector<NodeId>& seeds,
-                         std::size_t n) const noexcept
-        -> double final;
-
-    auto cascadeBackwardN(const std::vector<NodeId>& seeds,
-                          std::size_t n) const noexcept
-        -> double final;
-
-
-private:
-  auto forwardInfluence(std::vector<NodeId> seeds, dsfmt_t dsfmt) const noexcept
-        -> std::size_t;
+    LinearThresholdModel(const Graph& /* graph */) noexcept {}
+
+    /**
+     * activates everything the nodes in the work queue of the scratch activate
+     */
+    template<bool Backward, class Scratch, class EdgesOf>
+    auto spread(Scratch& scratch,
+                const EdgesOf& edges_of,
+                util::RandomGenerator& generator) const noexcept
+        -> void
+    {
+        auto& work_queue = scratch.workQueue();
+
+        while(!work_queue.empty()) {
+            auto current = work_queue.back();
+            work_queue.pop_back();
+
+            for(const auto& e : edges_of(current)) {
+                auto destination = e.getDestination();
+
+                if(scratch.isActivated(destination)) {
+                    continue;
+                }
+                if(scratch.touch(destination)) {
+                    // actually assign the threshold
+                    scratch.threshold(destination) = generator.nextDouble();
+                    scratch.input(destination) = 0.0f;
+                }
+                scratch.input(destination) += e.getWeight();
+
+                if(scratch.threshold(destination) <= scratch.input(destination)) {
+                    scratch.activate(destination);
+                    work_queue.emplace_back(destination);
+                }
+            }
+        }
+    }
+};
 
-  auto backwardInfluence(std::vector<NodeId> seeds, dsfmt_t dsfmt) const noexcept
-        -> std::size_t;
+using LinearThresholdEvaluation = CascadeEngine<LinearThresholdModel>;
 
-    const Graph& graph_;
-};
+// instantiated once in LinearThreshold.cpp
+extern template class CascadeEngine<LinearThresholdModel>;
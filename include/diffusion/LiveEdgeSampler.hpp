@@ -0,0 +1,148 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <cmath>
+#include <util/PackedArray.hpp>
+#include <util/Random.hpp>
+#include <vector>
+
+/**
+ * samples the live edges of a node in the independent cascade model with random numbers per live edge instead of per edge.
+ * The edges of every node are grouped by their probability (the weighted cascade weights of the inverse edges form a
+ * single group, the trivalency weights three groups). Inside a group the gap to the next live edge is a geometric
+ * random variate, hence low probability edges are skipped without drawing a random number for each of them.
+ * If the groups are too small to pay off (e.g. the forward edges of weighted cascade weights, which all differ),
+ * the edges of the graph are sampled one by one.
+ * The destinations are only copied in group order if a node has more than one group
+ */
+class LiveEdgeSampler
+{
+public:
+    /**
+     * @param backward true if the inverse edges should be sampled
+     */
+    LiveEdgeSampler(const Graph& graph, bool backward);
+
+    /**
+     * calls visit(destination) for every live edge of the node
+     */
+    template<class Visit>
+    auto forEachLiveEdge(NodeId node,
+                         util::RandomGenerator& generator,
+                         Visit&& visit) const noexcept
+        -> void
+    {
+        forEachLiveEdge(
+            node,
+            generator,
+            [](auto /* destination */) { return true; },
+            visit);
+    }
+
+    /**
+     * calls visit(destination) for every live edge of the node whose destination is a candidate,
+     * edges which are sampled one by one are only drawn if is_candidate(destination) holds
+     */
+    template<class Candidate, class Visit>
+    auto forEachLiveEdge(NodeId node,
+                         util::RandomGenerator& generator,
+                         Candidate&& is_candidate,
+                         Visit&& visit) const noexcept
+        -> void
+    {
+        graph_.visitEdges(backward_, [&](auto edges_of) {
+            forEachLiveEdge(node, edges_of, generator, is_candidate, visit);
+        });
+    }
+
+    /**
+     * like forEachLiveEdge above, but the edges which are sampled one by one are taken from edges_of(node)
+     * (see Graph::visitEdges), which has to match the direction of the sampler
+     */
+    template<class EdgesOf, class Candidate, class Visit>
+    auto forEachLiveEdge(NodeId node,
+                         const EdgesOf& edges_of,
+                         util::RandomGenerator& generator,
+                         Candidate&& is_candidate,
+                         Visit&& visit) const noexcept
+        -> void
+    {
+        if(!grouped_) {
+            for(const auto& edge : edges_of(node)) {
+                const auto destination = edge.getDestination();
+                if(is_candidate(destination) and edge.getWeight() > generator.nextDouble()) {
+                    visit(destination);
+                }
+            }
+            return;
+        }
+
+        const auto edges = edges_of(node);
+        for(auto run = run_offsets_[node]; run < run_offsets_[node + 1]; ++run) {
+            const auto& group = runs_[run];
+            const auto end = runs_[run + 1].begin;
+            if(group.probability <= 0.0f) {
+                continue;
+            }
+
+            // without a reordered copy the node has a single group, which covers its edges of the graph
+            const auto destination_of = [&](std::size_t edge) {
+                return reordered_ ? static_cast<NodeId>(destinations_.get(edge))
+                                  : static_cast<NodeId>(edges[edge - group.begin].getDestination());
+            };
+
+            // dense groups are cheaper with one coin flip per edge than with a logarithm per live edge
+            if(group.probability >= SKIP_THRESHOLD or end - group.begin == 1) {
+                for(auto edge = group.begin; edge < end; ++edge) {
+                    const auto destination = destination_of(edge);
+                    if(is_candidate(destination) and group.probability > generator.nextDouble()) {
+                        visit(destination);
+                    }
+                }
+                continue;
+            }
+
+            // P(gap >= i) = (1 - p)^i, 1 - nextDouble() is in (0, 1]
+            for(auto edge = group.begin;;) {
+                const auto gap = std::floor(std::log(1.0 - generator.nextDouble())
+                                            * static_cast<double>(group.inverse_log_failure));
+                if(gap >= static_cast<double>(end - edge)) {
+                    break;
+                }
+                edge += static_cast<std::size_t>(gap);
+                const auto destination = destination_of(edge);
+                if(is_candidate(destination)) {
+                    visit(destination);
+                }
+                ++edge;
+            }
+        }
+    }
+
+private:
+    // groups with at least this probability flip one coin per edge
+    static constexpr float SKIP_THRESHOLD = 0.25f;
+    // the edges are only grouped if the groups have at least this many edges on average
+    static constexpr double MIN_AVERAGE_GROUP_SIZE = 2.0;
+
+    struct Run
+    {
+        // first edge of the group in destinations_, the group ends with the next run
+        std::size_t begin;
+        float probability;
+        // 1 / log(1 - probability)
+        float inverse_log_failure;
+    };
+
+    const Graph& graph_;
+    const bool backward_;
+    bool grouped_ = false;
+    // true if the edges of some node are copied into destinations_ in group order
+    bool reordered_ = false;
+
+    // the edges of a node keep their index range of the graph, but are sorted by probability
+    util::PackedArray destinations_;
+    // groups of node v are runs_[run_offsets_[v], run_offsets_[v + 1]), the last run is a sentinel
+    std::vector<std::size_t> run_offsets_;
+    std::vector<Run> runs_;
+};
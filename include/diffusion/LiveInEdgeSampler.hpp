@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <algorithm>
+#include <optional>
+#include <util/Random.hpp>
+#include <vector>
+
+/**
+ * samples the live in-edge of a node in the linear threshold model.
+ * In the live edge view of the model every node keeps at most one of its in-edges, the edge (u, v) with probability
+ * w(u, v) and none with probability 1 - sum of the weights (the weights are scaled down if they sum to more than 1).
+ * Nodes whose in-edges share one weight (weighted cascade, uniform weights) pick the edge directly from the random number,
+ * the other nodes use an alias table over their inverse edges, hence every sample costs O(1)
+ */
+class LiveInEdgeSampler
+{
+public:
+    LiveInEdgeSampler(const Graph& graph);
+
+    /**
+     * @return source of the live in-edge of the node, none if the node has no live in-edge
+     */
+    auto sample(NodeId node, util::RandomGenerator& generator) const noexcept
+        -> std::optional<NodeId>
+    {
+        const auto& in_edges = nodes_[node];
+        const auto random = generator.nextDouble();
+        if(random >= in_edges.total) {
+            return std::nullopt;
+        }
+
+        // the random number below total is reused to draw the edge
+        const auto position = random / in_edges.total * static_cast<double>(in_edges.size);
+        auto edge = std::min(static_cast<std::uint32_t>(position), in_edges.size - 1);
+        if(!in_edges.equal_weights) {
+            const auto first = graph_.getInverseEdgeOffsetOf(node);
+            if(position - edge >= acceptance_[first + edge]) {
+                edge = aliases_[first + edge];
+            }
+        }
+
+        return graph_.getInverseEdgesOf(node)[edge].getDestination();
+    }
+
+private:
+    struct InEdges
+    {
+        // probability that the node has a live in-edge
+        double total = 0.0;
+        std::uint32_t size = 0;
+        // if all in-edges have the same weight, the alias table of the node is not needed
+        bool equal_weights = true;
+    };
+
+    const Graph& graph_;
+    std::vector<InEdges> nodes_;
+    // alias tables of the nodes with different weights, indexed like the inverse edges of the graph
+    std::vector<float> acceptance_;
+    std::vector<std::uint32_t> aliases_;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <diffusion/BitParallelCascade.hpp>
+#include <diffusion/DiffusionModelInterface.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/**
+ * independent cascade model which evaluates every seed set on the same sampled live edge graphs (snapshots).
+ * The live edges are sampled once, 64 worlds at a time as one bit mask per edge,
+ * and the pool grows to the largest number of simulations requested so far.
+ * Evaluating a seed set is then a bit parallel reachability search without any random numbers,
+ * and all seed sets are compared on the same worlds (common random numbers).
+ * A pool of n worlds needs n/8 bytes per edge and direction. Every pool may use a quarter of the physical memory,
+ * evaluations which need a larger pool simulate fresh worlds (see BitParallelCascader) instead.
+ */
+class SnapshotCascader final : public DiffusionModelInterface
+{
+public:
+    SnapshotCascader(const Graph& graph) noexcept;
+
+    auto cascadeForwardN(const std::vector<NodeId>& seeds,
+                         std::size_t n) const noexcept
+        -> double final;
+
+    auto cascadeBackwardN(const std::vector<NodeId>& seeds,
+                          std::size_t n) const noexcept
+        -> double final;
+
+    /**
+     * the adaptive evaluation needs independent worlds in every call,
+     * hence the samples are drawn freshly and not taken from the pool
+     */
+    auto sampleForwardN(const std::vector<NodeId>& seeds,
+                        std::size_t n) const noexcept
+        -> util::RunningStatistics final;
+
+    auto sampleBackwardN(const std::vector<NodeId>& seeds,
+                         std::size_t n) const noexcept
+        -> util::RunningStatistics final;
+
+    auto cascadeForwardCurveN(const std::vector<NodeId>& seeds,
+                              std::size_t n) const noexcept
+        -> std::vector<double> final;
+
+private:
+    struct SnapshotPool
+    {
+        std::uint64_t family;
+        // live worlds of every edge, one array per 64 worlds.
+        // The arrays do not move when the pool grows, hence evaluations keep using them without the mutex
+        std::vector<std::unique_ptr<std::uint64_t[]>> batches;
+        // the fallback to fresh worlds is only reported once
+        bool reported_limit = false;
+        std::mutex mutex;
+    };
+
+    /**
+     * samples the live edges of the pool until it holds the given number of batches
+     * @return the first number_of_batches batches of the pool,
+     * nullopt if the pool would exceed its memory limit, the pool is unchanged then
+     */
+    auto growPool(SnapshotPool& pool,
+                  std::size_t number_of_batches,
+                  bool backward) const noexcept
+        -> std::optional<std::vector<const std::uint64_t*>>;
+
+    auto cascadeN(const std::vector<NodeId>& seeds,
+                  std::size_t n,
+                  bool backward) const noexcept
+        -> double;
+
+    const Graph& graph_;
+    // bytes one pool may use
+    const std::size_t max_pool_bytes_;
+    BitParallelCascader fresh_worlds_;
+    mutable SnapshotPool forward_pool_;
+    mutable SnapshotPool backward_pool_;
+};
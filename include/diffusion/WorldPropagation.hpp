@@ -0,0 +1,288 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <util/Random.hpp>
+#include <util/RunningStatistics.hpp>
+#include <vector>
+
+/**
+ * building blocks of the bit parallel independent cascade models,
+ * every bit of a WorldMask belongs to one simulation (world)
+ */
+namespace bitparallel {
+
+using WorldMask = std::uint64_t;
+
+constexpr std::size_t WORLDS_PER_MASK = std::numeric_limits<WorldMask>::digits;
+
+// nodes with less than 1/DEFER_RATIO of the pending worlds of the fullest frontier node wait for more worlds
+constexpr int DEFER_RATIO = 4;
+
+/**
+ * @return mask of the first n worlds
+ */
+inline auto firstWorlds(std::size_t n) noexcept
+    -> WorldMask
+{
+    return n >= WORLDS_PER_MASK
+        ? ~WorldMask{0}
+        : (WorldMask{1} << n) - 1;
+}
+
+/**
+ * draws a mask in which every bit of the candidates is set with the given probability.
+ * A uniform random number is compared to the probability bit by bit, starting with the most significant bit,
+ * the comparison of a world is decided at the first differing bit.
+ * Every word decides half of the remaining worlds, hence a mask costs about log2(64) random words
+ */
+inline auto drawLiveWorlds(float probability,
+                           WorldMask candidates,
+                           util::RandomGenerator& generator) noexcept
+    -> WorldMask
+{
+    if(probability >= 1.0f) {
+        return candidates;
+    }
+    if(probability <= 0.0f) {
+        return 0;
+    }
+
+    const auto threshold = static_cast<std::uint32_t>(static_cast<double>(probability) * 0x1.0p32);
+
+    WorldMask live = 0;
+    auto undecided = candidates;
+    for(int bit = 31; bit >= 0 and undecided != 0; --bit) {
+        const auto random = generator.next();
+        if((threshold >> bit) & 1u) {
+            // random bit 0 < probability bit 1
+            live |= undecided & ~random;
+            undecided &= random;
+        } else {
+            // random bit 1 > probability bit 0
+            undecided &= ~random;
+        }
+    }
+
+    // the remaining worlds drew exactly the threshold, which is not smaller than it
+    return live;
+}
+
+struct NodeWorlds
+{
+    // worlds in which the node is active
+    WorldMask active = 0;
+    // worlds in which the node was activated, but its edges were not tried yet
+    WorldMask pending = 0;
+};
+
+/**
+ * per thread workspace, only the touched nodes are cleared after a batch
+ */
+struct WorldScratch
+{
+    // both masks of a node share a cache line
+    std::vector<NodeWorlds> worlds;
+    std::vector<NodeId> touched;
+    std::vector<NodeId> frontier;
+    std::vector<NodeId> next_frontier;
+    // sum of the activated nodes over all worlds
+    std::size_t activated = 0;
+
+    static auto local(std::size_t number_of_nodes)
+        -> WorldScratch&
+    {
+        thread_local WorldScratch scratch;
+        if(scratch.worlds.size() < number_of_nodes) {
+            scratch.worlds.resize(number_of_nodes);
+        }
+        return scratch;
+    }
+};
+
+/**
+ * activates the seed in the given worlds, its edges are tried by the next spreadWorlds
+ */
+inline auto activateSeed(WorldScratch& scratch,
+                         NodeId seed,
+                         WorldMask worlds) noexcept
+    -> void
+{
+    auto& seed_worlds = scratch.worlds[seed];
+    const auto newly_active = worlds & ~seed_worlds.active;
+    if(newly_active == 0) {
+        return;
+    }
+
+    if(seed_worlds.active == 0) {
+        scratch.touched.emplace_back(seed);
+    }
+    if(seed_worlds.pending == 0) {
+        scratch.frontier.emplace_back(seed);
+    }
+    seed_worlds.active |= newly_active;
+    seed_worlds.pending |= newly_active;
+    scratch.activated += std::popcount(newly_active);
+}
+
+/**
+ * runs the cascades of all pending worlds until no node is pending anymore.
+ * live_worlds(edge, edge_index, candidates) returns the candidate worlds in which the edge is live,
+ * edge_index is the index of the edge in the graph (see Graph::getEdgeOffsetOf)
+ */
+template<class LiveWorlds>
+auto spreadWorlds(const Graph& graph,
+                  WorldScratch& scratch,
+                  bool backward,
+                  LiveWorlds&& live_worlds) noexcept
+    -> void
+{
+    auto& node_worlds = scratch.worlds;
+    auto& frontier = scratch.frontier;
+    auto& next_frontier = scratch.next_frontier;
+
+    graph.visitEdges(backward, [&](auto edges_of) {
+        // the edges of a node are tried exactly once in every world after it was activated.
+        // The outcome does not depend on the order in which this happens, hence nodes with only a few
+        // pending worlds are deferred to the next round, in which they may have collected more worlds
+        while(!frontier.empty()) {
+            int max_pending = 0;
+            for(auto current : frontier) {
+                max_pending = std::max(max_pending, std::popcount(node_worlds[current].pending));
+            }
+            const auto min_pending = max_pending / DEFER_RATIO;
+
+            for(auto current : frontier) {
+                if(std::popcount(node_worlds[current].pending) < min_pending) {
+                    next_frontier.emplace_back(current);
+                    continue;
+                }
+
+                const auto newly_active = node_worlds[current].pending;
+                node_worlds[current].pending = 0;
+
+                const auto edges = edges_of(current);
+                const auto first_edge = backward
+                    ? graph.getInverseEdgeOffsetOf(current)
+                    : graph.getEdgeOffsetOf(current);
+
+                for(std::size_t i = 0; i < edges.size(); ++i) {
+                    const auto e = edges[i];
+                    auto& destination = node_worlds[e.getDestination()];
+                    const auto candidates = newly_active & ~destination.active;
+                    if(candidates == 0) {
+                        continue;
+                    }
+
+                    const auto live = live_worlds(e, first_edge + i, candidates);
+                    if(live == 0) {
+                        continue;
+                    }
+
+                    if(destination.active == 0) {
+                        scratch.touched.emplace_back(e.getDestination());
+                    }
+                    if(destination.pending == 0) {
+                        next_frontier.emplace_back(e.getDestination());
+                    }
+                    destination.active |= live;
+                    destination.pending |= live;
+                    scratch.activated += std::popcount(live);
+                }
+            }
+
+            frontier.clear();
+            std::swap(frontier, next_frontier);
+        }
+    });
+}
+
+/**
+ * resets the touched nodes for the next batch,
+ * the activated nodes of every single world are added to per_world if it is given
+ */
+inline auto clearWorlds(WorldScratch& scratch,
+                        WorldMask worlds,
+                        util::RunningStatistics* per_world) noexcept
+    -> void
+{
+    std::array<std::size_t, WORLDS_PER_MASK> activated_in_world{};
+    for(auto node : scratch.touched) {
+        auto active = scratch.worlds[node].active;
+        scratch.worlds[node].active = 0;
+
+        // the activated nodes of every single world are only needed for the variance
+        for(; per_world != nullptr and active != 0; active &= active - 1) {
+            ++activated_in_world[std::countr_zero(active)];
+        }
+    }
+    scratch.touched.clear();
+    scratch.activated = 0;
+
+    if(per_world != nullptr) {
+        for(std::size_t world = 0; world < WORLDS_PER_MASK; ++world) {
+            if((worlds >> world) & 1u) {
+                per_world->add(static_cast<double>(activated_in_world[world]));
+            }
+        }
+    }
+}
+
+/**
+ * runs the cascades of the given worlds at once (see spreadWorlds)
+ * @return sum of the activated nodes over all worlds
+ */
+template<class LiveWorlds>
+auto propagateWorlds(const Graph& graph,
+                     const std::vector<NodeId>& seeds,
+                     WorldMask worlds,
+                     bool backward,
+                     LiveWorlds&& live_worlds,
+                     util::RunningStatistics* per_world) noexcept
+    -> std::size_t
+{
+    auto& scratch = WorldScratch::local(graph.getNumberOfNodes());
+
+    for(auto seed : seeds) {
+        activateSeed(scratch, seed, worlds);
+    }
+    spreadWorlds(graph, scratch, backward, live_worlds);
+
+    const auto activated = scratch.activated;
+    clearWorlds(scratch, worlds, per_world);
+
+    return activated;
+}
+
+/**
+ * adds the seeds one after another to the given worlds and extends their cascades
+ * @return sum of the activated nodes over all worlds after every seed
+ */
+template<class LiveWorlds>
+auto propagateWorldsCurve(const Graph& graph,
+                          const std::vector<NodeId>& seeds,
+                          WorldMask worlds,
+                          bool backward,
+                          LiveWorlds&& live_worlds) noexcept
+    -> std::vector<std::size_t>
+{
+    auto& scratch = WorldScratch::local(graph.getNumberOfNodes());
+
+    std::vector<std::size_t> curve;
+    curve.reserve(seeds.size());
+    for(auto seed : seeds) {
+        activateSeed(scratch, seed, worlds);
+        spreadWorlds(graph, scratch, backward, live_worlds);
+        curve.emplace_back(scratch.activated);
+    }
+
+    clearWorlds(scratch, worlds, nullptr);
+
+    return curve;
+}
+
+} // namespace bitparallel
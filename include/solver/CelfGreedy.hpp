@@ -16,10 +16,20 @@ public:
         -> std::string final;
 
 private:
+    /**
+     * estimates the spread of every single node (the first CELF round) in parallel over the nodes.
+     * All nodes are evaluated on the same sampled worlds (common random numbers), which are sampled
+     * 64 at a time as one live edge mask per edge, hence only the masks of one batch are kept in memory
+     */
+    auto initializeSpreads() noexcept
+        -> void;
+
     auto evaluateSpread(NodeId node, std::vector<NodeId> &seed_set) const noexcept
         -> double;
 
-    auto singleSimulation(NodeId node, std::vector<NodeId> &seed_set) const noexcept
+    auto singleSimulation(NodeId node,
+                          std::vector<NodeId> &seed_set,
+                          util::RandomGenerator &generator) const noexcept
         -> long;
 
     const Graph &graph_;
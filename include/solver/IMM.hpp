@@ -2,31 +2,53 @@
 #pragma once
 
 #include <Graph.hpp>
-#include <dSFMT.h>
-#include <mutex>
+#include <diffusion/LiveEdgeSampler.hpp>
+#include <diffusion/LiveInEdgeSampler.hpp>
+#include <optional>
 #include <random>
+#include <solver/MaxCoverage.hpp>
+#include <solver/RrSetStore.hpp>
 #include <solver/SolverInterface.hpp>
 #include <unordered_set>
+#include <util/Definitions.hpp>
 
 class IMM final : public SolverInterface
 {
 public:
-    IMM(const Graph& graph)
+    /**
+     * @param diffusion_model model in which the influence is maximized, the rr sets of the linear threshold model
+     * are reverse random walks, all other models are independent cascade models
+     * @param rr_set_path file in which the rr sets are kept between runs (see writeRrSetFile),
+     * stored rr sets are reused and only the missing ones are sampled
+     */
+    IMM(const Graph& graph,
+        util::DiffusionModel diffusion_model = util::DiffusionModel::INDEPENDENT_CASCADE,
+        std::optional<std::string> rr_set_path = std::nullopt)
     noexcept;
 
     auto solve(std::size_t k) noexcept
         -> std::vector<NodeId> final;
 
+    /**
+     * writes the rr sets into the rr set file if solve sampled new ones,
+     * called after solve, hence writing the file is not part of its runtime
+     * @return false if the file could not be written
+     */
+    auto storeRrSets()
+        -> bool;
+
     auto name() const noexcept
         -> std::string final;
 
 private:
     /**
-     * creates and returns a random rr set
-     * @return random rr set
+     * creates a random rr set
+     * @param generator random stream of this rr set
+     * @param rr_set the nodes of the rr set are appended to it
      */
-    auto createRrSet(dsfmt_t dsfmt) const noexcept
-        -> std::vector<NodeId>;
+    auto createRrSet(util::RandomGenerator& generator,
+                     std::vector<RrSetStore::NodeIndex>& rr_set) const noexcept
+        -> void;
 
 
     /**
@@ -36,13 +58,23 @@ private:
         -> double;
 
     /**
-     * selects the k best nodes according to the previously sampled rr sets
+     * selects the k best nodes according to the previously sampled rr sets,
+     * only the rr sets sampled since the last call are added to the inverted index
      * @param k number of nodes to be selected
      * @return tuple: (vector of selected nodes, double value: fraction of rr sets that are covered by the selected nodes)
      */
-    auto nodeSelection(std::size_t k) const noexcept
+    auto nodeSelection(std::size_t k) noexcept
         -> std::pair<std::vector<NodeId>, double>;
 
     const Graph& graph_;
-    std::vector<std::vector<NodeId>> rr_sets_;
+    // INDEPENDENT_CASCADE or LINEAR_THRESHOLD
+    const util::DiffusionModel diffusion_model_;
+    // only the sampler of the diffusion model is built
+    std::optional<LiveEdgeSampler> inverse_edges_;
+    std::optional<LiveInEdgeSampler> live_in_edges_;
+    RrSetStore rr_sets_;
+    MaxCoverage coverage_;
+    std::optional<std::string> rr_set_path_;
+    // number of rr sets read from the rr set file
+    std::size_t stored_rr_sets_ = 0;
 };
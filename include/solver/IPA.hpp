@@ -2,6 +2,7 @@
 
 #include "SolverInterface.hpp"
 #include <Graph.hpp>
+#include <unordered_map>
 #include <unordered_set>
 
 struct path_element
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <cstdint>
+#include <solver/RrSetStore.hpp>
+#include <vector>
+
+/**
+ * greedy maximum coverage of rr sets.
+ * The rr sets containing a node are stored in a flat inverted index (CSR node -> rr set ids),
+ * the node covering the most uncovered rr sets is taken from a lazy max-heap of integer coverage counters.
+ * Counters only decrease, hence an outdated heap entry is just pushed again with its current counter.
+ * Selecting the seeds costs O(sum of the rr set sizes * log |V|).
+ * The index grows with the rr set store, extend() only adds the rr sets sampled since the last call
+ */
+class MaxCoverage
+{
+public:
+    using RrSetIndex = std::uint32_t;
+
+    MaxCoverage(const RrSetStore& rr_sets, std::size_t number_of_nodes);
+
+    /**
+     * adds the rr sets to the index which were appended to the store since the last call
+     */
+    auto extend()
+        -> void;
+
+    /**
+     * selects k nodes greedily, ties are broken by the smaller node id
+     * @return tuple: (vector of selected nodes, fraction of rr sets that are covered by the selected nodes)
+     */
+    auto select(std::size_t k) const
+        -> std::pair<std::vector<NodeId>, double>;
+
+private:
+    const RrSetStore& rr_sets_;
+    const std::size_t number_of_nodes_;
+    // number of rr sets in the index
+    std::size_t indexed_ = 0;
+
+    // rr sets containing node v are rr_set_ids_[node_offsets_[v], node_offsets_[v + 1])
+    std::vector<std::size_t> node_offsets_;
+    std::vector<RrSetIndex> rr_set_ids_;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Graph.hpp>
+#include <solver/RrSetStore.hpp>
+#include <string_view>
+#include <util/Definitions.hpp>
+
+/**
+ * writes the rr sets into a binary file, which can be reused by later runs for any k.
+ * The node ids of every rr set are sorted, delta encoded and stored as varints.
+ * The header identifies the graph (sizes and Graph::getFingerprint of the inverse edges) and the diffusion model
+ * @return true if the file was written successfully
+ */
+auto writeRrSetFile(std::string_view path,
+                    const RrSetStore& rr_sets,
+                    const Graph& graph,
+                    util::DiffusionModel diffusion_model)
+    -> bool;
+
+/**
+ * maps a file written by writeRrSetFile and appends its rr sets to the store
+ * @return false if the file does not exist, is corrupted or was written for another graph or diffusion model,
+ * the store is unchanged then
+ */
+auto readRrSetFile(std::string_view path,
+                   RrSetStore& rr_sets,
+                   const Graph& graph,
+                   util::DiffusionModel diffusion_model)
+    -> bool;
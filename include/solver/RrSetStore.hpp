@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <fmt/core.h>
+#include <span>
+#include <util/PackedArray.hpp>
+#include <util/Range.hpp>
+#include <vector>
+
+/**
+ * append only storage of reverse reachable (rr) sets in CSR layout:
+ * the 32 bit node ids of all rr sets are stored in one contiguous array, rr set i is nodes[offsets[i], offsets[i + 1]).
+ * New rr sets are sampled in parallel chunks, every chunk writes into its own buffer without any lock
+ * and the buffers are appended in index order, hence rr set i is always the same set for the same random streams.
+ */
+class RrSetStore
+{
+public:
+    using NodeIndex = std::uint32_t;
+
+    explicit RrSetStore(std::size_t number_of_nodes)
+    {
+        if(!util::PackedArray::fitsNarrow(number_of_nodes)) {
+            fmt::print("rr sets store node ids with 32 bits, the graph has {} nodes\n", number_of_nodes);
+            std::exit(1);
+        }
+    }
+
+    /**
+     * samples the rr sets with the indices [size(), count) in parallel and appends them.
+     * sample(index, nodes) has to append the nodes of the rr set with the given index to nodes
+     */
+    template<class Sampler>
+    auto extend(std::size_t count, Sampler&& sample)
+        -> void
+    {
+        const auto first = size();
+        if(count <= first) {
+            return;
+        }
+
+        const auto number_of_chunks = (count - first + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        std::vector<Chunk> chunks(number_of_chunks);
+
+        std::for_each(
+            std::execution::par,
+            std::begin(utils::range(number_of_chunks)),
+            std::end(utils::range(number_of_chunks)),
+            [&](auto chunk_index) {
+                auto& chunk = chunks[chunk_index];
+                const auto begin = first + chunk_index * CHUNK_SIZE;
+                const auto end = std::min(begin + CHUNK_SIZE, count);
+
+                chunk.sizes.reserve(end - begin);
+                for(auto index = begin; index < end; ++index) {
+                    const auto old_size = chunk.nodes.size();
+                    sample(index, chunk.nodes);
+                    chunk.sizes.emplace_back(chunk.nodes.size() - old_size);
+                }
+            });
+
+        // every chunk is copied to its position in the contiguous arrays
+        std::vector<std::size_t> chunk_offsets(number_of_chunks + 1, nodes_.size());
+        for(auto i : utils::range(number_of_chunks)) {
+            chunk_offsets[i + 1] = chunk_offsets[i] + chunks[i].nodes.size();
+        }
+
+        nodes_.resize(chunk_offsets.back());
+        offsets_.resize(count + 1);
+
+        std::for_each(
+            std::execution::par,
+            std::begin(utils::range(number_of_chunks)),
+            std::end(utils::range(number_of_chunks)),
+            [&](auto chunk_index) {
+                const auto& chunk = chunks[chunk_index];
+                std::copy(std::begin(chunk.nodes),
+                          std::end(chunk.nodes),
+                          std::begin(nodes_) + chunk_offsets[chunk_index]);
+
+                auto offset = chunk_offsets[chunk_index];
+                auto index = first + chunk_index * CHUNK_SIZE;
+                for(auto set_size : chunk.sizes) {
+                    offset += set_size;
+                    offsets_[++index] = offset;
+                }
+            });
+    }
+
+    /**
+     * appends a single rr set, used to load stored rr sets
+     */
+    auto append(std::span<const NodeIndex> rr_set)
+        -> void
+    {
+        nodes_.insert(std::end(nodes_), std::begin(rr_set), std::end(rr_set));
+        offsets_.emplace_back(nodes_.size());
+    }
+
+    /**
+     * removes all rr sets from the given index on, used to undo an incomplete load
+     */
+    auto truncate(std::size_t number_of_rr_sets)
+        -> void
+    {
+        offsets_.resize(number_of_rr_sets + 1);
+        nodes_.resize(offsets_.back());
+    }
+
+    auto reserve(std::size_t number_of_rr_sets, std::size_t number_of_entries)
+        -> void
+    {
+        offsets_.reserve(number_of_rr_sets + 1);
+        nodes_.reserve(number_of_entries);
+    }
+
+    /**
+     * @return number of rr sets
+     */
+    auto size() const noexcept
+        -> std::size_t
+    {
+        return offsets_.size() - 1;
+    }
+
+    auto operator[](std::size_t index) const noexcept
+        -> std::span<const NodeIndex>
+    {
+        return {nodes_.data() + offsets_[index], nodes_.data() + offsets_[index + 1]};
+    }
+
+    /**
+     * @return sum of the sizes of all rr sets
+     */
+    auto numberOfEntries() const noexcept
+        -> std::size_t
+    {
+        return nodes_.size();
+    }
+
+private:
+    // rr sets sampled by one task, small enough to balance rr sets of very different sizes
+    static constexpr std::size_t CHUNK_SIZE = 256;
+
+    struct Chunk
+    {
+        std::vector<NodeIndex> nodes;
+        std::vector<std::size_t> sizes;
+    };
+
+    std::vector<NodeIndex> nodes_;
+    std::vector<std::size_t> offsets_ = {0};
+};
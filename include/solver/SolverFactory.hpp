@@ -3,7 +3,9 @@
 
 #include <Graph.hpp>
 #include <memory>
+#include <optional>
 #include <solver/SolverInterface.hpp>
+#include <util/Definitions.hpp>
 
 class SolverFactory
 {
@@ -13,8 +15,14 @@ public:
      * @param arguments vertex list holding the algorithms (and their parameters)
      * @param graph
      * @param bm Benchmarker object
+     * @param diffusion_model model in which IMM maximizes the influence
+     * @param rr_set_path file in which IMM keeps its rr sets between runs
      * @return
      */
-    static auto benchmarkAll(const std::vector<std::string>& arguments, Graph& graph, Benchmarker& bm) noexcept
+    static auto benchmarkAll(const std::vector<std::string>& arguments,
+                             Graph& graph,
+                             Benchmarker& bm,
+                             util::DiffusionModel diffusion_model = util::DiffusionModel::INDEPENDENT_CASCADE,
+                             const std::optional<std::string>& rr_set_path = std::nullopt) noexcept
         -> void;
 };
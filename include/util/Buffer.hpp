@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace util {
+
+/**
+ * Contiguous array which either owns its values or borrows them from external memory,
+ * e.g. a memory mapped graph file.
+ * Borrowed buffers are copied into owned memory on the first mutable access (copy on write),
+ * hence the const accessors should be used on borrowed buffers.
+ */
+template<class T>
+class Buffer
+{
+public:
+    Buffer() = default;
+
+    explicit Buffer(std::size_t size, T value = T{})
+        : owned_(size, value)
+    {
+        refresh();
+    }
+
+    Buffer(const Buffer&) = delete;
+    Buffer(Buffer&&) noexcept = default;
+
+    auto operator=(const Buffer&) -> Buffer& = delete;
+    auto operator=(Buffer&&) noexcept -> Buffer& = default;
+
+    /**
+     * creates a read-only buffer pointing to external memory
+     * the memory has to outlive the buffer
+     */
+    static auto borrow(const T* data, std::size_t size) noexcept
+        -> Buffer
+    {
+        Buffer buffer;
+        buffer.data_ = data;
+        buffer.size_ = size;
+        buffer.borrowed_ = true;
+        return buffer;
+    }
+
+    auto operator[](std::size_t index) const noexcept
+        -> const T&
+    {
+        return data_[index];
+    }
+
+    auto operator[](std::size_t index)
+        -> T&
+    {
+        makeOwned();
+        return owned_[index];
+    }
+
+    auto pushBack(T value)
+        -> void
+    {
+        makeOwned();
+        owned_.push_back(value);
+        refresh();
+    }
+
+    auto resize(std::size_t size, T value = T{})
+        -> void
+    {
+        makeOwned();
+        owned_.resize(size, value);
+        refresh();
+    }
+
+    auto reserve(std::size_t size)
+        -> void
+    {
+        makeOwned();
+        owned_.reserve(size);
+        refresh();
+    }
+
+    template<class Iterator>
+    auto assign(Iterator first, Iterator last)
+        -> void
+    {
+        owned_.assign(first, last);
+        borrowed_ = false;
+        refresh();
+    }
+
+    auto clear() noexcept
+        -> void
+    {
+        owned_ = {};
+        borrowed_ = false;
+        refresh();
+    }
+
+    auto data() const noexcept
+        -> const T*
+    {
+        return data_;
+    }
+
+    auto data()
+        -> T*
+    {
+        makeOwned();
+        return owned_.data();
+    }
+
+    auto size() const noexcept
+        -> std::size_t
+    {
+        return size_;
+    }
+
+    auto empty() const noexcept
+        -> bool
+    {
+        return size_ == 0;
+    }
+
+    auto isBorrowed() const noexcept
+        -> bool
+    {
+        return borrowed_;
+    }
+
+    auto begin() const noexcept
+        -> const T*
+    {
+        return data_;
+    }
+
+    auto end() const noexcept
+        -> const T*
+    {
+        return data_ + size_;
+    }
+
+    auto begin()
+        -> T*
+    {
+        makeOwned();
+        return owned_.data();
+    }
+
+    auto end()
+        -> T*
+    {
+        makeOwned();
+        return owned_.data() + owned_.size();
+    }
+
+private:
+    auto makeOwned()
+        -> void
+    {
+        if(borrowed_) {
+            owned_.assign(data_, data_ + size_);
+            borrowed_ = false;
+            refresh();
+        }
+    }
+
+    auto refresh() noexcept
+        -> void
+    {
+        data_ = owned_.data();
+        size_ = owned_.size();
+    }
+
+    std::vector<T> owned_;
+    const T* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool borrowed_ = false;
+};
+
+} // namespace util
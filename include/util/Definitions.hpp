@@ -9,7 +9,9 @@ using NodeId = std::int_fast64_t;
 
 enum class DiffusionModel : std::size_t {
     INDEPENDENT_CASCADE = 0,
-    LINEAR_THRESHOLD = 1
+    LINEAR_THRESHOLD = 1,
+    INDEPENDENT_CASCADE_BIT_PARALLEL = 2,
+    INDEPENDENT_CASCADE_SNAPSHOTS = 3
 };
 
 inline auto diffusionModelToString(DiffusionModel m)
@@ -23,8 +25,12 @@ inline auto diffusionModelToString(DiffusionModel m)
         return "Independent Cascade";
     case DiffusionModel::LINEAR_THRESHOLD:
         return "Linear Threshold";
+    case DiffusionModel::INDEPENDENT_CASCADE_BIT_PARALLEL:
+        return "Independent Cascade (bit parallel)";
+    case DiffusionModel::INDEPENDENT_CASCADE_SNAPSHOTS:
+        return "Independent Cascade (live edge snapshots)";
     default:
-        fmt::print("somehow an object of type DiffusionModel had a value which was not 0 or 1...\exiting...\n");
+        fmt::print("somehow an object of type DiffusionModel had a value which was not 0, 1, 2 or 3...\exiting...\n");
         std::exit(-1);
     }
 }
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace util {
+
+/**
+ * RAII wrapper around a read-only, shared memory mapping of a whole file.
+ * Since the mapping is shared, all processes mapping the same file use the same page cache pages.
+ */
+class MemoryMap
+{
+public:
+    MemoryMap() = default;
+
+    explicit MemoryMap(const std::string& path) noexcept
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            error_ = errno;
+            return;
+        }
+
+        struct stat file_stat
+        {};
+        if(::fstat(fd, &file_stat) != 0) {
+            error_ = errno;
+        } else if(file_stat.st_size == 0) {
+            // mmap rejects empty files
+            empty_file_ = true;
+        } else {
+            auto size = static_cast<std::size_t>(file_stat.st_size);
+            auto* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if(data != MAP_FAILED) {
+                data_ = data;
+                size_ = size;
+            } else {
+                error_ = errno;
+            }
+        }
+
+        ::close(fd);
+    }
+
+    MemoryMap(const MemoryMap&) = delete;
+    MemoryMap(MemoryMap&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          error_(other.error_),
+          empty_file_(other.empty_file_) {}
+
+    auto operator=(const MemoryMap&) -> MemoryMap& = delete;
+    auto operator=(MemoryMap&& other) noexcept
+        -> MemoryMap&
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(error_, other.error_);
+        std::swap(empty_file_, other.empty_file_);
+        return *this;
+    }
+
+    ~MemoryMap()
+    {
+        if(data_ != nullptr) {
+            ::munmap(data_, size_);
+        }
+    }
+
+    /**
+     * hints the kernel that the mapping will be read sequentially
+     */
+    auto adviseSequential() const noexcept
+        -> void
+    {
+        if(data_ != nullptr) {
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+    auto isValid() const noexcept
+        -> bool
+    {
+        return data_ != nullptr;
+    }
+
+    /**
+     * @return why the mapping is invalid, an empty file is reported separately from a missing or unreadable one
+     */
+    auto errorMessage() const
+        -> std::string
+    {
+        return empty_file_ ? "the file is empty" : std::strerror(error_);
+    }
+
+    auto data() const noexcept
+        -> const char*
+    {
+        return static_cast<const char*>(data_);
+    }
+
+    auto size() const noexcept
+        -> std::size_t
+    {
+        return size_;
+    }
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    // errno of the failed system call
+    int error_ = 0;
+    bool empty_file_ = false;
+};
+
+} // namespace util
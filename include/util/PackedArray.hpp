@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <util/Buffer.hpp>
+#include <utility>
+
+namespace util {
+
+/**
+ * Array of unsigned integers (node ids or edge offsets) which stores every entry with 32 bits
+ * if all values fit into 32 bits and with 64 bits otherwise.
+ * The width is chosen once while the graph is loaded, consumers read it through narrowData()/wideData().
+ */
+class PackedArray
+{
+public:
+    PackedArray() = default;
+
+    PackedArray(std::size_t size, bool wide)
+        : wide_(wide)
+    {
+        if(wide_) {
+            wide_values_.resize(size, 0);
+        } else {
+            narrow_values_.resize(size, 0);
+        }
+    }
+
+    /**
+     * creates a read-only array pointing to external memory holding 32 or 64 bit values
+     */
+    static auto borrow(const void* data, std::size_t size, bool wide) noexcept
+        -> PackedArray
+    {
+        PackedArray array;
+        array.wide_ = wide;
+        if(wide) {
+            array.wide_values_ = Buffer<std::uint64_t>::borrow(static_cast<const std::uint64_t*>(data), size);
+        } else {
+            array.narrow_values_ = Buffer<std::uint32_t>::borrow(static_cast<const std::uint32_t*>(data), size);
+        }
+        return array;
+    }
+
+    /**
+     * @return true if a value can be stored in the narrow (32 bit) representation
+     */
+    static auto fitsNarrow(std::uint64_t value) noexcept
+        -> bool
+    {
+        return value <= std::numeric_limits<std::uint32_t>::max();
+    }
+
+    auto get(std::size_t index) const noexcept
+        -> std::uint64_t
+    {
+        return wide_ ? std::as_const(wide_values_)[index] : std::as_const(narrow_values_)[index];
+    }
+
+    auto set(std::size_t index, std::uint64_t value) noexcept
+        -> void
+    {
+        if(wide_) {
+            wide_values_[index] = value;
+        } else {
+            narrow_values_[index] = static_cast<std::uint32_t>(value);
+        }
+    }
+
+    /**
+     * appends a value, switching to the wide representation if the value does not fit into 32 bits
+     */
+    auto pushBack(std::uint64_t value)
+        -> void
+    {
+        if(!wide_ and !fitsNarrow(value)) {
+            widen();
+        }
+
+        if(wide_) {
+            wide_values_.pushBack(value);
+        } else {
+            narrow_values_.pushBack(static_cast<std::uint32_t>(value));
+        }
+    }
+
+    /**
+     * converts the array to the narrow representation if every value fits into 32 bits
+     */
+    auto pack()
+        -> void
+    {
+        if(!wide_) {
+            return;
+        }
+
+        const auto& values = std::as_const(wide_values_);
+        auto max = std::max_element(std::begin(values), std::end(values));
+        if(max != std::end(values) and !fitsNarrow(*max)) {
+            return;
+        }
+
+        narrow_values_.assign(std::begin(values), std::end(values));
+        wide_values_.clear();
+        wide_ = false;
+    }
+
+    auto reserve(std::size_t size)
+        -> void
+    {
+        if(wide_) {
+            wide_values_.reserve(size);
+        } else {
+            narrow_values_.reserve(size);
+        }
+    }
+
+    auto size() const noexcept
+        -> std::size_t
+    {
+        return wide_ ? wide_values_.size() : narrow_values_.size();
+    }
+
+    auto isWide() const noexcept
+        -> bool
+    {
+        return wide_;
+    }
+
+    /**
+     * @return pointer to the 32 bit values or nullptr if the array uses the wide representation
+     */
+    auto narrowData() const noexcept
+        -> const std::uint32_t*
+    {
+        return wide_ ? nullptr : narrow_values_.data();
+    }
+
+    /**
+     * @return pointer to the 64 bit values or nullptr if the array uses the narrow representation
+     */
+    auto wideData() const noexcept
+        -> const std::uint64_t*
+    {
+        return wide_ ? wide_values_.data() : nullptr;
+    }
+
+    /**
+     * @return size of the stored values in bytes
+     */
+    auto byteSize() const noexcept
+        -> std::size_t
+    {
+        return wide_ ? size() * sizeof(std::uint64_t) : size() * sizeof(std::uint32_t);
+    }
+
+private:
+    auto widen()
+        -> void
+    {
+        const auto& values = std::as_const(narrow_values_);
+        wide_values_.assign(std::begin(values), std::end(values));
+        narrow_values_.clear();
+        wide_ = true;
+    }
+
+    bool wide_ = false;
+    Buffer<std::uint32_t> narrow_values_;
+    Buffer<std::uint64_t> wide_values_;
+};
+
+} // namespace util
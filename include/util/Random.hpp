@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+/**
+ * fast random number generator (xoshiro256+) whose state is derived from a (key, stream) pair
+ * with the counter based Philox4x32-10 function (Salmon et al. 2011).
+ * Creating a new independent stream is cheap and the numbers of a stream only depend on the pair,
+ * not on the thread which draws them.
+ */
+class RandomGenerator
+{
+public:
+    RandomGenerator(std::uint64_t key, std::uint64_t stream) noexcept
+    {
+        const auto first = philox(key, 0, stream);
+        const auto second = philox(key, 1, stream);
+        state_ = {combine(first[0], first[1]),
+                  combine(first[2], first[3]),
+                  combine(second[0], second[1]),
+                  combine(second[2], second[3])};
+
+        // the all zero state is the only invalid one
+        if(state_[0] == 0 and state_[1] == 0 and state_[2] == 0 and state_[3] == 0) {
+            state_[0] = 1;
+        }
+    }
+
+    auto next() noexcept
+        -> std::uint64_t
+    {
+        const auto result = state_[0] + state_[3];
+        const auto t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = (state_[3] << 45) | (state_[3] >> 19);
+
+        return result;
+    }
+
+    /**
+     * @return uniformly distributed double in [0, 1)
+     */
+    auto nextDouble() noexcept
+        -> double
+    {
+        // the upper 53 bits are the strongest ones of xoshiro256+
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * @return uniformly distributed integer in [0, bound)
+     */
+    auto nextBelow(std::uint64_t bound) noexcept
+        -> std::uint64_t
+    {
+        // multiply-shift range reduction (Lemire), the 128 bit product keeps the full range of 64 bit node ids
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(next()) * bound) >> 64);
+    }
+
+private:
+    static constexpr auto combine(std::uint32_t low, std::uint32_t high) noexcept
+        -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(high) << 32 | low;
+    }
+
+    static constexpr auto philox(std::uint64_t key, std::uint64_t counter, std::uint64_t stream) noexcept
+        -> std::array<std::uint32_t, 4>
+    {
+        constexpr std::uint64_t M0 = 0xD2511F53;
+        constexpr std::uint64_t M1 = 0xCD9E8D57;
+        constexpr std::uint32_t W0 = 0x9E3779B9;
+        constexpr std::uint32_t W1 = 0xBB67AE85;
+
+        std::array<std::uint32_t, 4> block = {static_cast<std::uint32_t>(counter),
+                                              static_cast<std::uint32_t>(counter >> 32),
+                                              static_cast<std::uint32_t>(stream),
+                                              static_cast<std::uint32_t>(stream >> 32)};
+        auto key0 = static_cast<std::uint32_t>(key);
+        auto key1 = static_cast<std::uint32_t>(key >> 32);
+
+        for(int round = 0; round < 10; ++round) {
+            const auto product0 = M0 * block[0];
+            const auto product1 = M1 * block[2];
+            block = {static_cast<std::uint32_t>(product1 >> 32) ^ block[1] ^ key0,
+                     static_cast<std::uint32_t>(product1),
+                     static_cast<std::uint32_t>(product0 >> 32) ^ block[3] ^ key1,
+                     static_cast<std::uint32_t>(product0)};
+            key0 += W0;
+            key1 += W1;
+        }
+
+        return block;
+    }
+
+    std::array<std::uint64_t, 4> state_;
+};
+
+/**
+ * process wide source of random streams, seeded once with the --seed option.
+ *
+ * Parallel loops request a stream family once outside of the loop and derive the stream of every iteration
+ * from its index (simulation, rr set, node, ...) with stream(family, index),
+ * the results are then reproducible independent of the thread scheduling.
+ */
+class RandomService
+{
+public:
+    static auto setSeed(std::uint64_t seed) noexcept
+        -> void
+    {
+        seed_ = seed;
+        families_ = 0;
+    }
+
+    static auto getSeed() noexcept
+        -> std::uint64_t
+    {
+        return seed_;
+    }
+
+    /**
+     * derives the stream families of the current thread from a key instead of the process wide counter,
+     * e.g. to run independent evaluations in parallel. The key has to be drawn outside of the parallel region.
+     * Scopes are nested like the stack, hence a task stolen while the thread waits restores the outer scope
+     */
+    class FamilyScope
+    {
+    public:
+        explicit FamilyScope(std::uint64_t key) noexcept
+            : key_(key),
+              outer_(scope_)
+        {
+            scope_ = this;
+        }
+
+        FamilyScope(const FamilyScope&) = delete;
+        auto operator=(const FamilyScope&) -> FamilyScope& = delete;
+
+        ~FamilyScope()
+        {
+            scope_ = outer_;
+        }
+
+    private:
+        friend class RandomService;
+
+        const std::uint64_t key_;
+        std::uint64_t families_ = 0;
+        FamilyScope* const outer_;
+    };
+
+    /**
+     * @return key of a new stream family, every call returns a different one.
+     * Must not be called from parallel regions unless a FamilyScope is active, otherwise the runs are not reproducible
+     */
+    static auto newStreamFamily() noexcept
+        -> std::uint64_t
+    {
+        if(scope_ != nullptr) {
+            return mix(scope_->key_ + mix(scope_->families_++));
+        }
+        return mix(seed_ + mix(families_.fetch_add(1, std::memory_order_relaxed)));
+    }
+
+    static auto stream(std::uint64_t family, std::uint64_t index) noexcept
+        -> RandomGenerator
+    {
+        return RandomGenerator{family, index};
+    }
+
+private:
+    // splitmix64 finalizer
+    static constexpr auto mix(std::uint64_t value) noexcept
+        -> std::uint64_t
+    {
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    static inline std::uint64_t seed_ = 0;
+    static inline std::atomic<std::uint64_t> families_ = 0;
+    static inline thread_local FamilyScope* scope_ = nullptr;
+};
+
+} // namespace util
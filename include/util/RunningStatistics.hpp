@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace util {
+
+/**
+ * numerically stable running mean and variance (Welford's method).
+ * Two statistics of disjoint samples can be merged (Chan et al.),
+ * hence it can be used as reduction type of parallel loops.
+ */
+class RunningStatistics
+{
+public:
+    RunningStatistics() noexcept = default;
+
+    auto add(double value) noexcept
+        -> void
+    {
+        ++count_;
+        const auto delta = value - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        squared_deviations_ += delta * (value - mean_);
+    }
+
+    auto merge(const RunningStatistics& other) noexcept
+        -> void
+    {
+        if(other.count_ == 0) {
+            return;
+        }
+        if(count_ == 0) {
+            *this = other;
+            return;
+        }
+
+        const auto count = count_ + other.count_;
+        const auto delta = other.mean_ - mean_;
+        const auto other_share = static_cast<double>(other.count_) / static_cast<double>(count);
+
+        mean_ += delta * other_share;
+        squared_deviations_ += other.squared_deviations_
+            + delta * delta * static_cast<double>(count_) * other_share;
+        count_ = count;
+    }
+
+    auto count() const noexcept
+        -> std::size_t
+    {
+        return count_;
+    }
+
+    auto mean() const noexcept
+        -> double
+    {
+        return mean_;
+    }
+
+    /**
+     * @return unbiased sample variance
+     */
+    auto variance() const noexcept
+        -> double
+    {
+        return count_ < 2 ? 0.0 : squared_deviations_ / static_cast<double>(count_ - 1);
+    }
+
+    /**
+     * @return standard error of the mean
+     */
+    auto standardError() const noexcept
+        -> double
+    {
+        return count_ == 0 ? 0.0 : std::sqrt(variance() / static_cast<double>(count_));
+    }
+
+private:
+    std::size_t count_ = 0;
+    double mean_ = 0.0;
+    double squared_deviations_ = 0.0;
+};
+
+} // namespace util
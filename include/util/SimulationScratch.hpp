@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace util {
+
+using NodeId = std::int_fast64_t;
+
+/**
+ * per thread workspace of the monte carlo simulations.
+ * Instead of allocating and clearing arrays of size |V| for every simulation,
+ * every entry is stamped with the epoch in which it was written. Starting a new simulation
+ * only increments the epoch, which invalidates all entries at once,
+ * hence a simulation costs O(cascade size) instead of O(|V|).
+ */
+class SimulationScratch
+{
+public:
+    /**
+     * @return workspace of the calling thread, reset for a new simulation on a graph with the given number of nodes
+     */
+    static auto local(std::size_t number_of_nodes)
+        -> SimulationScratch&
+    {
+        thread_local SimulationScratch scratch;
+        scratch.reset(number_of_nodes);
+        return scratch;
+    }
+
+    /**
+     * marks the node as activated
+     * @return true if the node was not activated before in this simulation
+     */
+    auto activate(NodeId node) noexcept
+        -> bool
+    {
+        if(activated_epoch_[node] == epoch_) {
+            return false;
+        }
+        activated_epoch_[node] = epoch_;
+        activated_.emplace_back(node);
+        return true;
+    }
+
+    auto isActivated(NodeId node) const noexcept
+        -> bool
+    {
+        return activated_epoch_[node] == epoch_;
+    }
+
+    /**
+     * @return nodes activated in this simulation (in activation order)
+     */
+    auto activatedNodes() const noexcept
+        -> const std::vector<NodeId>&
+    {
+        return activated_;
+    }
+
+    /**
+     * @return true the first time the node is visited in this simulation,
+     * its threshold and input (linear threshold model) have to be initialized then
+     */
+    auto touch(NodeId node) noexcept
+        -> bool
+    {
+        if(touched_epoch_[node] == epoch_) {
+            return false;
+        }
+        touched_epoch_[node] = epoch_;
+        return true;
+    }
+
+    auto threshold(NodeId node) noexcept
+        -> double&
+    {
+        return threshold_[node];
+    }
+
+    auto input(NodeId node) noexcept
+        -> float&
+    {
+        return input_[node];
+    }
+
+    /**
+     * @return empty queue which can be used by the simulation
+     */
+    auto workQueue() noexcept
+        -> std::vector<NodeId>&
+    {
+        return work_queue_;
+    }
+
+private:
+    auto reset(std::size_t number_of_nodes)
+        -> void
+    {
+        if(activated_epoch_.size() < number_of_nodes) {
+            activated_epoch_.resize(number_of_nodes, 0);
+            touched_epoch_.resize(number_of_nodes, 0);
+            threshold_.resize(number_of_nodes);
+            input_.resize(number_of_nodes);
+        }
+
+        // on overflow, the stamps of old epochs would become valid again
+        if(++epoch_ == 0) {
+            std::fill(std::begin(activated_epoch_), std::end(activated_epoch_), 0);
+            std::fill(std::begin(touched_epoch_), std::end(touched_epoch_), 0);
+            epoch_ = 1;
+        }
+
+        activated_.clear();
+        work_queue_.clear();
+    }
+
+    std::uint32_t epoch_ = 0;
+    std::vector<std::uint32_t> activated_epoch_;
+    std::vector<std::uint32_t> touched_epoch_;
+    std::vector<double> threshold_;
+    std::vector<float> input_;
+    std::vector<NodeId> activated_;
+    std::vector<NodeId> work_queue_;
+};
+
+} // namespace util
@@ -2,7 +2,6 @@
 #define DSFMT_MEXP 19937
 
 #include <Benchmarker.hpp>
-#include <random>
 #include <solver/SolverFactory.hpp>
 #include <tbb/tbb.h>
 
@@ -15,16 +14,20 @@ auto main(int argc, char* argv[])
     auto parse_mode = options.getParseMode();
     auto use_inverse = options.shouldUseInverseGraph();
     auto random_edge_weights = options.shouldUseRandomEdgeWeights();
+    auto relabel_ids = options.shouldRelabelIds();
     const auto& strategies = options.getSolvers();
     tbb::task_scheduler_init init(number_of_threads);
+    util::RandomService::setSeed(options.getSeed());
 
     Timer file_reading_timer = Timer();
     auto graph = [&] {
         switch(parse_mode) {
         case ParseMode::VERTEX_LIST:
-            return parseVertexListFile(graph_file, use_inverse, false, random_edge_weights, !options.printRaw());
+            return parseVertexListFile(graph_file, use_inverse, false, random_edge_weights, relabel_ids, !options.printRaw());
         case ParseMode::EDGE_LIST:
-            return parseEdgeListFile(graph_file, use_inverse, false, random_edge_weights, !options.printRaw());
+            return parseEdgeListFile(graph_file, use_inverse, false, random_edge_weights, relabel_ids, !options.printRaw());
+        case ParseMode::BINARY:
+            return parseBinaryFile(graph_file, use_inverse, random_edge_weights, !options.printRaw());
         default:
             fmt::print("unknown parse mode\n");
             std::exit(-1);
@@ -32,14 +35,18 @@ auto main(int argc, char* argv[])
     }();
     auto reading_time = file_reading_timer.elapsed();
 
-    // create random state for our "seed generator"
-    // use rd to make sure the seed is different in every execution
-    // using time could result in the same seed, if the program is started multiple times within one second
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, RAND_MAX);
-    srand(dis(gen));
+    reorderGraph(graph, options.getReorderStrategy(), !options.printRaw());
+
+    // converter mode
+    if(const auto& binary_path = options.getBinaryOutPath()) {
+        auto success = writeBinaryFile(graph, binary_path.value(), use_inverse, random_edge_weights);
+        return success ? 0 : 1;
+    }
+
+    if(const auto& probability = options.getUniformProbability()) {
+        graph.setUniformEdgeWeights(probability.value());
+    }
 
     Benchmarker bm{graph, options, reading_time};
-    SolverFactory::benchmarkAll(strategies, graph, bm);
+    SolverFactory::benchmarkAll(strategies, graph, bm, options.getDiffusionModel(), options.getRrSetPath());
 }
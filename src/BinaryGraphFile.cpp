@@ -0,0 +1,353 @@
+#include <Parser.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <execution>
+#include <fmt/core.h>
+#include <fstream>
+
+namespace {
+
+constexpr std::array<char, 8> BINARY_MAGIC = {'I', 'M', 'B', 'G', 'R', 'A', 'P', 'H'};
+constexpr std::uint32_t BINARY_VERSION = 3;
+constexpr std::size_t SECTION_ALIGNMENT = 64;
+
+enum class WeightModel : std::uint32_t {
+    WEIGHTED_CASCADE = 0,
+    RANDOM_TRIVALENCY = 1
+};
+
+struct BinaryGraphHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    WeightModel weight_model;
+    std::uint8_t inverse;
+    // width flags: forward offsets, forward destinations, backward offsets, backward destinations
+    std::array<std::uint8_t, 4> wide;
+    // WeightLayout of the forward and backward edges
+    std::array<WeightLayout, 2> weight_layouts;
+    std::uint8_t padding;
+    std::uint64_t number_of_nodes;
+    std::uint64_t number_of_edges;
+    std::uint64_t name_length;
+    // zero if the node ids were not relabeled during parsing
+    std::uint64_t number_of_original_ids;
+};
+
+// the order of the sections in the file, every section starts at a multiple of SECTION_ALIGNMENT
+enum Section : std::size_t {
+    NAME = 0,
+    FORWARD_OFFSETS,
+    FORWARD_DESTINATIONS,
+    FORWARD_WEIGHTS,
+    BACKWARD_OFFSETS,
+    BACKWARD_DESTINATIONS,
+    BACKWARD_WEIGHTS,
+    ORIGINAL_IDS,
+    END
+};
+
+auto align(std::size_t position) noexcept
+    -> std::size_t
+{
+    return (position + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+auto idWidth(bool wide) noexcept
+    -> std::size_t
+{
+    return wide ? sizeof(std::uint64_t) : sizeof(std::uint32_t);
+}
+
+// size of the weight section, only explicit weights are stored per edge
+auto weightSize(WeightLayout weight_layout, std::size_t nodes, std::size_t edges) noexcept
+    -> std::size_t
+{
+    switch(weight_layout) {
+    case WeightLayout::EXPLICIT:
+        return edges * sizeof(float);
+    case WeightLayout::PER_DESTINATION:
+    case WeightLayout::PER_SOURCE:
+        return nodes * sizeof(float);
+    case WeightLayout::UNIFORM:
+        return sizeof(float);
+    case WeightLayout::TRIVALENCY:
+        return (edges + weights::CLASSES_PER_BYTE - 1) / weights::CLASSES_PER_BYTE;
+    default:
+        return 0;
+    }
+}
+
+// the edge storage is private to the graph, hence the type is deduced
+template<class EdgeStorage>
+auto weightData(const EdgeStorage& storage) noexcept
+    -> std::pair<const char*, std::size_t>
+{
+    switch(storage.weight_layout) {
+    case WeightLayout::UNIFORM:
+        return {reinterpret_cast<const char*>(&storage.uniform_weight), sizeof(float)};
+    case WeightLayout::TRIVALENCY:
+        return {reinterpret_cast<const char*>(storage.weight_classes.data()), storage.weight_classes.size()};
+    default:
+        return {reinterpret_cast<const char*>(storage.weights.data()), storage.weights.size() * sizeof(float)};
+    }
+}
+
+template<class EdgeStorage>
+auto borrowWeights(EdgeStorage& storage,
+                   WeightLayout weight_layout,
+                   const char* data,
+                   std::size_t size) noexcept
+    -> void
+{
+    storage.weight_layout = weight_layout;
+    switch(weight_layout) {
+    case WeightLayout::UNIFORM:
+        std::memcpy(&storage.uniform_weight, data, sizeof(float));
+        break;
+    case WeightLayout::TRIVALENCY:
+        storage.weight_classes = util::Buffer<std::uint8_t>::borrow(reinterpret_cast<const std::uint8_t*>(data), size);
+        break;
+    default:
+        storage.weights = util::Buffer<float>::borrow(reinterpret_cast<const float*>(data), size / sizeof(float));
+        break;
+    }
+}
+
+/**
+ * @return true if every count of the header fits into a file of the given size on its own,
+ * afterwards the section layout can be computed without overflows
+ */
+auto hasPlausibleSizes(const BinaryGraphHeader& header, std::size_t file_size) noexcept
+    -> bool
+{
+    const auto fits = [&](std::uint64_t count, std::size_t width) {
+        return count <= file_size / width;
+    };
+
+    const auto valid_layout = [](WeightLayout weight_layout) {
+        return static_cast<std::uint8_t>(weight_layout) <= static_cast<std::uint8_t>(WeightLayout::TRIVALENCY);
+    };
+
+    const auto valid_flag = [](std::uint8_t flag) {
+        return flag <= 1;
+    };
+
+    return std::all_of(std::begin(header.wide), std::end(header.wide), valid_flag)
+        and valid_flag(header.inverse)
+        and fits(header.name_length, 1)
+        and fits(header.number_of_nodes, sizeof(std::uint32_t))
+        and fits(header.number_of_edges, sizeof(std::uint32_t))
+        and fits(header.number_of_original_ids, sizeof(std::uint64_t))
+        // the original ids are indexed by the internal ids
+        and (header.number_of_original_ids == 0 or header.number_of_original_ids == header.number_of_nodes)
+        and valid_layout(header.weight_layouts[0])
+        and valid_layout(header.weight_layouts[1]);
+}
+
+/**
+ * @return true if the offsets start at 0, never decrease and end at the number of edges,
+ * and every destination is a node of the graph
+ */
+auto hasConsistentEdges(const util::PackedArray& offsets,
+                        const util::PackedArray& destinations,
+                        std::uint64_t nodes,
+                        std::uint64_t edges) noexcept
+    -> bool
+{
+    if(offsets.get(0) != 0 or offsets.get(nodes) != edges) {
+        return false;
+    }
+
+    const auto node_range = utils::range(nodes);
+    const auto edge_range = utils::range(edges);
+    return std::all_of(std::execution::par,
+                       std::begin(node_range),
+                       std::end(node_range),
+                       [&](auto node) {
+                           return offsets.get(node) <= offsets.get(node + 1);
+                       })
+        and std::all_of(std::execution::par,
+                        std::begin(edge_range),
+                        std::end(edge_range),
+                        [&](auto edge) {
+                            return destinations.get(edge) < nodes;
+                        });
+}
+
+// calculates the start position of all sections from the header, see hasPlausibleSizes
+auto sectionLayout(const BinaryGraphHeader& header) noexcept
+    -> std::array<std::size_t, END + 1>
+{
+    const auto nodes = header.number_of_nodes;
+    const auto edges = header.number_of_edges;
+
+    std::array<std::size_t, END + 1> layout{};
+    layout[NAME] = sizeof(BinaryGraphHeader);
+    layout[FORWARD_OFFSETS] = align(layout[NAME] + header.name_length);
+    layout[FORWARD_DESTINATIONS] = align(layout[FORWARD_OFFSETS] + (nodes + 1) * idWidth(header.wide[0]));
+    layout[FORWARD_WEIGHTS] = align(layout[FORWARD_DESTINATIONS] + edges * idWidth(header.wide[1]));
+    layout[BACKWARD_OFFSETS] = align(layout[FORWARD_WEIGHTS] + weightSize(header.weight_layouts[0], nodes, edges));
+    layout[BACKWARD_DESTINATIONS] = align(layout[BACKWARD_OFFSETS] + (nodes + 1) * idWidth(header.wide[2]));
+    layout[BACKWARD_WEIGHTS] = align(layout[BACKWARD_DESTINATIONS] + edges * idWidth(header.wide[3]));
+    layout[ORIGINAL_IDS] = align(layout[BACKWARD_WEIGHTS] + weightSize(header.weight_layouts[1], nodes, edges));
+    layout[END] = layout[ORIGINAL_IDS] + header.number_of_original_ids * sizeof(std::uint64_t);
+    return layout;
+}
+
+auto packedData(const util::PackedArray& array) noexcept
+    -> const char*
+{
+    return array.isWide()
+        ? reinterpret_cast<const char*>(array.wideData())
+        : reinterpret_cast<const char*>(array.narrowData());
+}
+
+} // namespace
+
+auto writeBinaryFile(const Graph& graph,
+                     std::string_view path,
+                     bool inverse,
+                     bool random_edge_weights)
+    -> bool
+{
+    std::ofstream out_file{path.data(), std::ios::out | std::ios::binary};
+
+    if(!out_file) {
+        fmt::print("could not open {} for writing\n", path);
+        return false;
+    }
+
+    const auto& forward = graph.forward_;
+    const auto& backward = graph.backward_;
+    const auto name = graph.getGraphName();
+
+    BinaryGraphHeader header{};
+    header.magic = BINARY_MAGIC;
+    header.version = BINARY_VERSION;
+    header.weight_model = random_edge_weights
+        ? WeightModel::RANDOM_TRIVALENCY
+        : WeightModel::WEIGHTED_CASCADE;
+    header.inverse = inverse;
+    header.wide = {forward.offsets.isWide(),
+                   forward.destinations.isWide(),
+                   backward.offsets.isWide(),
+                   backward.destinations.isWide()};
+    header.weight_layouts = {forward.weight_layout, backward.weight_layout};
+    header.number_of_nodes = graph.getNumberOfNodes();
+    header.number_of_edges = graph.getNumberOfEdges();
+    header.name_length = name.size();
+    header.number_of_original_ids = graph.original_ids_.size();
+
+    const auto layout = sectionLayout(header);
+    const std::array<std::pair<const char*, std::size_t>, END> sections = {
+        std::pair{name.data(), name.size()},
+        std::pair{packedData(forward.offsets), forward.offsets.byteSize()},
+        std::pair{packedData(forward.destinations), forward.destinations.byteSize()},
+        weightData(forward),
+        std::pair{packedData(backward.offsets), backward.offsets.byteSize()},
+        std::pair{packedData(backward.destinations), backward.destinations.byteSize()},
+        weightData(backward),
+        std::pair{reinterpret_cast<const char*>(graph.original_ids_.data()), graph.original_ids_.size() * sizeof(std::uint64_t)}};
+
+    out_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for(std::size_t section = NAME; section < END; ++section) {
+        // pad up to the start of the section
+        const auto position = static_cast<std::size_t>(out_file.tellp());
+        const std::vector<char> padding(layout[section] - position, 0);
+        out_file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        auto [data, size] = sections[section];
+        out_file.write(data, static_cast<std::streamsize>(size));
+    }
+
+    return static_cast<bool>(out_file);
+}
+
+auto parseBinaryFile(std::string_view path,
+                     bool inverse,
+                     bool random_edge_weights,
+                     bool should_log)
+    -> Graph
+{
+    auto mapping = std::make_unique<util::MemoryMap>(std::string{path});
+
+    if(!mapping->isValid()) {
+        fmt::print("Could not read file {}: {}\n", path, mapping->errorMessage());
+        std::exit(1);
+    }
+
+    BinaryGraphHeader header{};
+    if(mapping->size() < sizeof(header)) {
+        fmt::print("File {} is not a binary graph file\n", path);
+        std::exit(1);
+    }
+    std::memcpy(&header, mapping->data(), sizeof(header));
+
+    if(header.magic != BINARY_MAGIC or header.version != BINARY_VERSION) {
+        fmt::print("File {} is not a binary graph file of version {}\n", path, BINARY_VERSION);
+        std::exit(1);
+    }
+
+    if(!hasPlausibleSizes(header, mapping->size())) {
+        fmt::print("binary graph file {} is corrupted\n", path);
+        std::exit(1);
+    }
+
+    const auto layout = sectionLayout(header);
+    if(mapping->size() < layout[END]) {
+        fmt::print("binary graph file {} is truncated\n", path);
+        std::exit(1);
+    }
+
+    const auto expected_model = random_edge_weights
+        ? WeightModel::RANDOM_TRIVALENCY
+        : WeightModel::WEIGHTED_CASCADE;
+    if(header.weight_model != expected_model or static_cast<bool>(header.inverse) != inverse) {
+        fmt::print("binary graph file {} was written with different options (inverse: {}, random edge weights: {})\n",
+                   path,
+                   static_cast<bool>(header.inverse),
+                   header.weight_model == WeightModel::RANDOM_TRIVALENCY);
+        std::exit(1);
+    }
+
+    const auto* base = mapping->data();
+    const auto nodes = header.number_of_nodes;
+    const auto edges = header.number_of_edges;
+
+    Graph graph{std::string{base + layout[NAME], header.name_length}};
+
+    graph.forward_.offsets = util::PackedArray::borrow(base + layout[FORWARD_OFFSETS], nodes + 1, header.wide[0]);
+    graph.forward_.destinations = util::PackedArray::borrow(base + layout[FORWARD_DESTINATIONS], edges, header.wide[1]);
+    borrowWeights(graph.forward_,
+                  header.weight_layouts[0],
+                  base + layout[FORWARD_WEIGHTS],
+                  weightSize(header.weight_layouts[0], nodes, edges));
+    graph.backward_.offsets = util::PackedArray::borrow(base + layout[BACKWARD_OFFSETS], nodes + 1, header.wide[2]);
+    graph.backward_.destinations = util::PackedArray::borrow(base + layout[BACKWARD_DESTINATIONS], edges, header.wide[3]);
+    borrowWeights(graph.backward_,
+                  header.weight_layouts[1],
+                  base + layout[BACKWARD_WEIGHTS],
+                  weightSize(header.weight_layouts[1], nodes, edges));
+    graph.original_ids_ = util::Buffer<std::uint64_t>::borrow(reinterpret_cast<const std::uint64_t*>(base + layout[ORIGINAL_IDS]),
+                                                              header.number_of_original_ids);
+
+    // the edges are read without bound checks later on
+    if(!hasConsistentEdges(graph.forward_.offsets, graph.forward_.destinations, nodes, edges)
+       or !hasConsistentEdges(graph.backward_.offsets, graph.backward_.destinations, nodes, edges)) {
+        fmt::print("binary graph file {} is corrupted\n", path);
+        std::exit(1);
+    }
+
+    graph.mapping_ = std::move(mapping);
+
+    if(should_log) {
+        fmt::print("mapped binary graph file {} ({} MB)\n",
+                   path,
+                   graph.mapping_->size() / (1024 * 1024));
+    }
+
+    return graph;
+}
@@ -1,35 +1,64 @@
 #include <Graph.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
+#include <cstring>
+#include <execution>
+#include <numeric>
 
 Graph::Graph(std::string path)
     : graph_name_(std::move(path))
 {
-    forward_offset_array_.push_back(0);
-    backward_offset_array_.push_back(0);
+    forward_.offsets.pushBack(0);
+}
 
-    dsfmt_init_gen_rand(&dsfmt_, rand());
+auto Graph::EdgeStorage::edgesOf(NodeId node) const noexcept
+    -> EdgeRange
+{
+    const auto value = weight_layout == WeightLayout::PER_SOURCE ? weights[node] : uniform_weight;
+    return edgesOf(node, weights::Dynamic{weight_layout, weights.data(), weight_classes.data(), value});
 }
 
-auto Graph::getEdgesOf(NodeId node) const
-    -> nonstd::span<const Edge>
+auto Graph::EdgeStorage::setWeightClass(std::size_t edge, std::uint8_t weight_class) noexcept
+    -> void
+{
+    const auto shift = edge % weights::CLASSES_PER_BYTE * 2;
+    std::atomic_ref byte{weight_classes[edge / weights::CLASSES_PER_BYTE]};
+    byte.fetch_and(static_cast<std::uint8_t>(~(0b11u << shift)), std::memory_order_relaxed);
+    byte.fetch_or(static_cast<std::uint8_t>(weight_class << shift), std::memory_order_relaxed);
+}
+
+auto Graph::EdgeStorage::weightClassOf(std::size_t edge) noexcept
+    -> std::uint8_t
 {
-    auto start_offset = forward_offset_array_[node];
-    auto end_offset = forward_offset_array_[node + 1];
-    const auto* start = &forward_edges_[start_offset];
-    const auto* end = &forward_edges_[end_offset];
+    const auto shift = edge % weights::CLASSES_PER_BYTE * 2;
+    std::atomic_ref byte{weight_classes[edge / weights::CLASSES_PER_BYTE]};
+    return (byte.load(std::memory_order_relaxed) >> shift) & 0b11u;
+}
 
-    return {start, end};
+auto Graph::getEdgesOf(NodeId node) const
+    -> EdgeRange
+{
+    return forward_.edgesOf(node);
 }
 
 auto Graph::getInverseEdgesOf(NodeId node) const
-    -> nonstd::span<const Edge>
+    -> EdgeRange
+{
+    return backward_.edgesOf(node);
+}
+
+auto Graph::getEdgeOffsetOf(NodeId node) const noexcept
+    -> std::size_t
 {
-    auto start_offset = backward_offset_array_[node];
-    auto end_offset = backward_offset_array_[node + 1];
-    const auto* start = &backward_edges_[start_offset];
-    const auto* end = &backward_edges_[end_offset];
+    return forward_.offsets.get(node);
+}
 
-    return {start, end};
+auto Graph::getInverseEdgeOffsetOf(NodeId node) const noexcept
+    -> std::size_t
+{
+    return backward_.offsets.get(node);
 }
 
 auto Graph::getOutDegreeOf(NodeId node) const
@@ -47,13 +76,13 @@ auto Graph::getInDegreeOf(NodeId node) const
 auto Graph::getNumberOfNodes() const
     -> std::int64_t
 {
-    return forward_offset_array_.size() - 1;
+    return forward_.offsets.size() - 1;
 }
 
 auto Graph::getNumberOfEdges() const
     -> std::int64_t
 {
-    return forward_edges_.size();
+    return forward_.destinations.size();
 }
 
 auto Graph::getGraphName() const
@@ -62,45 +91,287 @@ auto Graph::getGraphName() const
     return graph_name_;
 }
 
-auto Graph::appendNode(NodeId /*node*/, std::vector<Edge> edges)
+auto Graph::buildForwardEdges(const util::PackedArray& sources,
+                              const util::PackedArray& destinations,
+                              const util::Buffer<float>& weights,
+                              std::size_t number_of_nodes)
     -> void
 {
-    std::move(std::begin(edges),
-              std::end(edges),
-              std::back_inserter(forward_edges_));
-
-    forward_offset_array_.push_back(forward_edges_.size());
+    const auto number_of_edges = sources.size();
+    const auto edge_range = utils::range(number_of_edges);
+    const auto has_weights = !weights.empty();
+
+    // out-degree histogram and prefix sum
+    std::vector<std::uint64_t> cursor(number_of_nodes + 1, 0);
+    std::for_each(std::execution::par,
+                  std::begin(edge_range),
+                  std::end(edge_range),
+                  [&](auto edge_pointer) {
+                      std::atomic_ref counter{cursor[sources.get(edge_pointer) + 1]};
+                      counter.fetch_add(1, std::memory_order_relaxed);
+                  });
+
+    std::inclusive_scan(std::execution::par,
+                        std::begin(cursor),
+                        std::end(cursor),
+                        std::begin(cursor));
+
+    forward_.offsets = util::PackedArray(number_of_nodes + 1, !util::PackedArray::fitsNarrow(number_of_edges));
+    forward_.destinations = util::PackedArray(number_of_edges, !util::PackedArray::fitsNarrow(number_of_nodes));
+    // files without weights get the weighted cascade weights later on, which are not stored per edge
+    forward_.weight_layout = has_weights ? WeightLayout::EXPLICIT : WeightLayout::UNKNOWN;
+    forward_.weights = has_weights ? util::Buffer<float>(number_of_edges) : util::Buffer<float>{};
+
+    const auto offset_range = utils::range(number_of_nodes + 1);
+    std::for_each(std::execution::par,
+                  std::begin(offset_range),
+                  std::end(offset_range),
+                  [&](auto n) {
+                      forward_.offsets.set(n, cursor[n]);
+                  });
+
+    // scatter the edges to their sources
+    std::for_each(std::execution::par,
+                  std::begin(edge_range),
+                  std::end(edge_range),
+                  [&](auto edge_pointer) {
+                      std::atomic_ref slot{cursor[sources.get(edge_pointer)]};
+                      auto position = slot.fetch_add(1, std::memory_order_relaxed);
+                      forward_.destinations.set(position, destinations.get(edge_pointer));
+                      if(has_weights) {
+                          forward_.weights[position] = weights[edge_pointer];
+                      }
+                  });
+
+    forward_.sortAdjacencies();
 }
 
-
 auto Graph::calculateBackwardEdges()
     -> void
 {
-    auto number_of_nodes = getNumberOfNodes();
+    // choose the compact storage if ids and offsets fit into 32 bits
+    forward_.offsets.pack();
+    forward_.destinations.pack();
 
-    std::vector<std::vector<Edge>> adjacency_list(number_of_nodes);
-
-    // calculate the back-edge adjacency list
-    for(NodeId from{0}; from < number_of_nodes; from++) {
-        auto edges = getEdgesOf(from);
-        for(auto e : edges) {
-            auto to = e.getDestination();
-            auto weight = e.getWeight();
-            Edge back_e{from, weight};
-            adjacency_list[to].push_back(back_e);
-        }
+    auto number_of_nodes = getNumberOfNodes();
+    auto wide_offsets = !util::PackedArray::fitsNarrow(getNumberOfEdges());
+    auto wide_destinations = !util::PackedArray::fitsNarrow(number_of_nodes);
+
+    auto nodes = getNodes();
+
+    // in-degree histogram
+    std::vector<std::uint64_t> cursor(number_of_nodes + 1, 0);
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto from) {
+                      for(auto e : getEdgesOf(from)) {
+                          std::atomic_ref counter{cursor[e.getDestination() + 1]};
+                          counter.fetch_add(1, std::memory_order_relaxed);
+                      }
+                  });
+
+    // prefix sum, afterwards cursor[n] is the first backward edge of node n
+    std::inclusive_scan(std::execution::par,
+                        std::begin(cursor),
+                        std::end(cursor),
+                        std::begin(cursor));
+
+    backward_.offsets = util::PackedArray(number_of_nodes + 1, wide_offsets);
+    backward_.destinations = util::PackedArray(getNumberOfEdges(), wide_destinations);
+    // per edge weights are scattered together with the edges, the node values of the weighted cascade
+    // weights of the forward edges belong to the sources of the backward edges
+    backward_.weight_layout = forward_.weight_layout;
+    backward_.uniform_weight = forward_.uniform_weight;
+    switch(forward_.weight_layout) {
+    case WeightLayout::EXPLICIT:
+        backward_.weights = util::Buffer<float>(getNumberOfEdges());
+        break;
+    case WeightLayout::TRIVALENCY:
+        backward_.weight_classes = util::Buffer<std::uint8_t>(forward_.weight_classes.size());
+        break;
+    case WeightLayout::PER_DESTINATION:
+    case WeightLayout::PER_SOURCE:
+        backward_.weight_layout = forward_.weight_layout == WeightLayout::PER_DESTINATION
+            ? WeightLayout::PER_SOURCE
+            : WeightLayout::PER_DESTINATION;
+        backward_.weights.assign(std::begin(forward_.weights), std::end(forward_.weights));
+        break;
+    default:
+        break;
     }
 
-    // adjacency list to offset array
-    for(NodeId n{0}; n < number_of_nodes; n++) {
-        auto edges = std::move(adjacency_list[n]);
+    std::for_each(std::execution::par,
+                  std::begin(utils::range(number_of_nodes + 1)),
+                  std::end(utils::range(number_of_nodes + 1)),
+                  [&](auto n) {
+                      backward_.offsets.set(n, cursor[n]);
+                  });
+
+    // scatter every edge to its slot in the backward arrays
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto from) {
+                      auto forward_edge = forward_.offsets.get(from);
+                      for(auto e : getEdgesOf(from)) {
+                          std::atomic_ref slot{cursor[e.getDestination()]};
+                          auto edge_pointer = slot.fetch_add(1, std::memory_order_relaxed);
+                          backward_.destinations.set(edge_pointer, from);
+                          if(backward_.weight_layout == WeightLayout::EXPLICIT) {
+                              backward_.weights[edge_pointer] = e.getWeight();
+                          } else if(backward_.weight_layout == WeightLayout::TRIVALENCY) {
+                              backward_.setWeightClass(edge_pointer,
+                                                       weights::trivalencyClassOf(forward_.weight_classes.data(), forward_edge));
+                          }
+                          ++forward_edge;
+                      }
+                  });
+
+    // the scatter order depends on the thread scheduling,
+    // sort the edges of every node by id to keep the graph deterministic
+    backward_.sortAdjacencies();
+}
 
-        std::move(std::begin(edges),
-                  std::end(edges),
-                  std::back_inserter(backward_edges_));
+auto Graph::EdgeStorage::sortAdjacencies()
+    -> void
+{
+    const auto nodes = utils::range(static_cast<std::int64_t>(offsets.size()) - 1);
+
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto n) {
+                      auto begin = offsets.get(n);
+                      auto end = offsets.get(n + 1);
+
+                      auto is_sorted = true;
+                      for(auto i = begin + 1; i < end and is_sorted; ++i) {
+                          is_sorted = destinations.get(i - 1) < destinations.get(i);
+                      }
+                      if(is_sorted) {
+                          return;
+                      }
+
+                      // the per edge weight (float bits or class) moves along with the destination
+                      thread_local std::vector<std::pair<std::uint64_t, std::uint32_t>> buffer;
+                      buffer.clear();
+                      for(auto i = begin; i < end; ++i) {
+                          std::uint32_t weight = 0;
+                          if(weight_layout == WeightLayout::EXPLICIT) {
+                              weight = std::bit_cast<std::uint32_t>(weights[i]);
+                          } else if(weight_layout == WeightLayout::TRIVALENCY) {
+                              // neighbouring nodes may share the byte and set their classes concurrently
+                              weight = weightClassOf(i);
+                          }
+                          buffer.emplace_back(destinations.get(i), weight);
+                      }
+
+                      std::sort(std::begin(buffer), std::end(buffer));
+
+                      for(auto i = begin; i < end; ++i) {
+                          const auto [destination, weight] = buffer[i - begin];
+                          destinations.set(i, destination);
+                          if(weight_layout == WeightLayout::EXPLICIT) {
+                              weights[i] = std::bit_cast<float>(weight);
+                          } else if(weight_layout == WeightLayout::TRIVALENCY) {
+                              setWeightClass(i, static_cast<std::uint8_t>(weight));
+                          }
+                      }
+                  });
+}
 
-        backward_offset_array_.push_back(backward_edges_.size());
+auto Graph::EdgeStorage::permuted(const std::vector<NodeId>& order,
+                                   const std::vector<NodeId>& rank) const
+    -> EdgeStorage
+{
+    const auto number_of_nodes = order.size();
+    const auto number_of_edges = destinations.size();
+
+    // degree of every new node and prefix sum
+    std::vector<std::uint64_t> first_edge(number_of_nodes + 1, 0);
+    const auto nodes = utils::range(number_of_nodes);
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto n) {
+                      first_edge[n + 1] = edgesOf(order[n]).size();
+                  });
+
+    std::inclusive_scan(std::execution::par,
+                        std::begin(first_edge),
+                        std::end(first_edge),
+                        std::begin(first_edge));
+
+    EdgeStorage storage;
+    storage.offsets = util::PackedArray(number_of_nodes + 1, offsets.isWide());
+    storage.destinations = util::PackedArray(number_of_edges, destinations.isWide());
+    storage.weight_layout = weight_layout;
+    storage.uniform_weight = uniform_weight;
+    const auto per_node_weights = weight_layout == WeightLayout::PER_DESTINATION
+        or weight_layout == WeightLayout::PER_SOURCE;
+    if(weight_layout == WeightLayout::EXPLICIT) {
+        storage.weights = util::Buffer<float>(number_of_edges);
+    } else if(per_node_weights) {
+        storage.weights = util::Buffer<float>(number_of_nodes);
+    } else if(weight_layout == WeightLayout::TRIVALENCY) {
+        storage.weight_classes = util::Buffer<std::uint8_t>(weight_classes.size());
     }
+
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto n) {
+                      auto edge_pointer = first_edge[n];
+                      auto old_edge_pointer = offsets.get(order[n]);
+                      storage.offsets.set(n + 1, first_edge[n + 1]);
+                      if(per_node_weights) {
+                          storage.weights[n] = weights[order[n]];
+                      }
+                      for(auto e : edgesOf(order[n])) {
+                          storage.destinations.set(edge_pointer, rank[e.getDestination()]);
+                          if(weight_layout == WeightLayout::EXPLICIT) {
+                              storage.weights[edge_pointer] = e.getWeight();
+                          } else if(weight_layout == WeightLayout::TRIVALENCY) {
+                              storage.setWeightClass(edge_pointer,
+                                                     weights::trivalencyClassOf(weight_classes.data(), old_edge_pointer));
+                          }
+                          ++edge_pointer;
+                          ++old_edge_pointer;
+                      }
+                  });
+
+    storage.sortAdjacencies();
+    return storage;
+}
+
+auto Graph::permute(const std::vector<NodeId>& order)
+    -> void
+{
+    const auto nodes = getNodes();
+
+    std::vector<NodeId> rank(order.size());
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto n) {
+                      rank[order[n]] = n;
+                  });
+
+    forward_ = forward_.permuted(order, rank);
+    backward_ = backward_.permuted(order, rank);
+
+    util::Buffer<std::uint64_t> original_ids(order.size());
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto n) {
+                      original_ids[n] = static_cast<std::uint64_t>(getOriginalId(order[n]));
+                  });
+    original_ids_ = std::move(original_ids);
+
+    // nothing points into a mapped binary graph file anymore
+    mapping_.reset();
 }
 
 auto Graph::inverse()
@@ -109,11 +380,7 @@ auto Graph::inverse()
     //activate ADL, this is best practice when using swap
     using std::swap;
 
-    swap(forward_offset_array_,
-         backward_offset_array_);
-
-    swap(forward_edges_,
-         backward_edges_);
+    swap(forward_, backward_);
 }
 
 
@@ -126,23 +393,44 @@ auto Graph::getNodes() const
 
 auto Graph::calculateEdgeWeights() -> void
 {
-    // todo implement different diffusion probabilities
-    // iterate edges for the forward edge list
-    for(auto& edge : forward_edges_) {
-        if(std::isnan(edge.getWeight())) {
-            edge.setWeight(1.0f / static_cast<float>(getInDegreeOf(edge.getDestination())));
+    // 1 / in-degree of every node, nodes without in-edges are never the destination of an edge
+    const auto nodes = getNodes();
+    util::Buffer<float> node_weights(getNumberOfNodes());
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto node) {
+                      node_weights[node] = 1.0f / static_cast<float>(getInDegreeOf(node));
+                  });
+
+    if(forward_.weight_layout == WeightLayout::EXPLICIT) {
+        // only the edges without a weight in the graph file are completed
+        for(std::size_t edge_pointer = 0; edge_pointer < forward_.weights.size(); ++edge_pointer) {
+            if(std::isnan(forward_.weights[edge_pointer])) {
+                auto destination = forward_.destinations.get(edge_pointer);
+                forward_.weights[edge_pointer] = node_weights[destination];
+            }
         }
+    } else {
+        forward_.weight_layout = WeightLayout::PER_DESTINATION;
+        forward_.weights.assign(std::begin(node_weights), std::end(node_weights));
+        forward_.weight_classes.clear();
     }
 
-    // iterate nodes and insert their weight into their backwards edges
-    // size -1 because the offset array needs an additional "end element"
-    for(NodeId current_node = 0; current_node < static_cast<NodeId>(backward_offset_array_.size() - 1); ++current_node) {
-        auto weight = 1.0f / static_cast<float>(getInDegreeOf(current_node));
-        auto edge_pointer = backward_offset_array_[current_node];
-        auto edge_end = backward_offset_array_[current_node + 1];
-        for(; edge_pointer < edge_end; ++edge_pointer) {
-            backward_edges_[edge_pointer].setWeight(weight);
-        }
+    // the inverse edges of a node share its weight
+    backward_.weight_layout = WeightLayout::PER_SOURCE;
+    backward_.weights = std::move(node_weights);
+    backward_.weight_classes.clear();
+}
+
+auto Graph::setUniformEdgeWeights(float probability)
+    -> void
+{
+    for(auto* storage : {&forward_, &backward_}) {
+        storage->weight_layout = WeightLayout::UNIFORM;
+        storage->uniform_weight = probability;
+        storage->weights.clear();
+        storage->weight_classes.clear();
     }
 }
 
@@ -150,40 +438,186 @@ auto Graph::assignRandomForwardEdgeWeights()
     -> void
 {
     //set forward edge weights
-    for(auto& edge : forward_edges_) {
-        auto rand = dsfmt_genrand_close_open(&dsfmt_);
-
-        if(rand < 0.333333) {
-            edge.setWeight(0.1f);
-        } else if(rand < 0.666666) {
-            edge.setWeight(0.01f);
-        } else {
-            edge.setWeight(0.001f);
-        }
-    }
+    forward_.assignRandomWeightClasses();
 }
 
 auto Graph::assignRandomBackwardEdgeWeights()
     -> void
 {
-    //set forward edge weights
-    for(auto& edge : backward_edges_) {
-        auto rand = dsfmt_genrand_close_open(&dsfmt_);
+    //set backward edge weights
+    backward_.assignRandomWeightClasses();
+}
 
+auto Graph::EdgeStorage::assignRandomWeightClasses()
+    -> void
+{
+    const auto number_of_edges = destinations.size();
+    weight_layout = WeightLayout::TRIVALENCY;
+    weights.clear();
+    weight_classes = util::Buffer<std::uint8_t>((number_of_edges + weights::CLASSES_PER_BYTE - 1) / weights::CLASSES_PER_BYTE);
+
+    auto generator = util::RandomService::stream(util::RandomService::newStreamFamily(), 0);
+    for(std::size_t edge = 0; edge < number_of_edges; ++edge) {
+        auto rand = generator.nextDouble();
+
+        // classes of weights::TRIVALENCY_PROBABILITIES
         if(rand < 0.333333) {
-            edge.setWeight(0.1f);
+            setWeightClass(edge, 0);
         } else if(rand < 0.666666) {
-            edge.setWeight(0.01f);
+            setWeightClass(edge, 1);
         } else {
-            edge.setWeight(0.001f);
+            setWeightClass(edge, 2);
         }
     }
 }
 
 
-auto Graph::getRandomNode() const noexcept
+auto Graph::getRandomNode(util::RandomGenerator& generator) const noexcept
     -> NodeId
 {
     const auto size = getNumberOfNodes();
-    return dsfmt_genrand_uint32_range(&dsfmt_, size);
+    return static_cast<NodeId>(generator.nextBelow(size));
+}
+
+auto Graph::getFingerprint(bool backward) const noexcept
+    -> std::uint64_t
+{
+    // FNV-1a
+    constexpr std::uint64_t FNV_PRIME = 0x100000001b3;
+    std::uint64_t hash = 0xcbf29ce484222325;
+
+    const auto mix = [&](std::uint64_t value) {
+        hash = (hash ^ value) * FNV_PRIME;
+    };
+
+    const auto& storage = backward ? backward_ : forward_;
+    mix(static_cast<std::uint64_t>(storage.weight_layout));
+    for(std::size_t node = 0; node < storage.offsets.size(); ++node) {
+        mix(storage.offsets.get(node));
+    }
+
+    switch(storage.weight_layout) {
+    case WeightLayout::UNIFORM:
+        mix(std::bit_cast<std::uint32_t>(storage.uniform_weight));
+        break;
+    case WeightLayout::PER_DESTINATION:
+    case WeightLayout::PER_SOURCE:
+        for(auto weight : storage.weights) {
+            mix(std::bit_cast<std::uint32_t>(weight));
+        }
+        break;
+    case WeightLayout::TRIVALENCY:
+        // the classes depend on the random seed, 32 of them are mixed at once
+        for(std::size_t i = 0; i < storage.weight_classes.size(); i += sizeof(std::uint64_t)) {
+            std::uint64_t word = 0;
+            std::memcpy(&word,
+                        storage.weight_classes.data() + i,
+                        std::min(sizeof(word), storage.weight_classes.size() - i));
+            mix(word);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return hash;
+}
+
+auto Graph::usesCompactStorage() const noexcept
+    -> bool
+{
+    return !forward_.offsets.isWide() and !forward_.destinations.isWide();
+}
+
+auto Graph::getOriginalId(NodeId node) const noexcept
+    -> NodeId
+{
+    if(original_ids_.empty()) {
+        return node;
+    }
+    return static_cast<NodeId>(original_ids_[node]);
+}
+
+auto Graph::getInternalId(NodeId original_id) const noexcept
+    -> std::optional<NodeId>
+{
+    if(original_ids_.empty()) {
+        if(original_id < 0 or original_id >= getNumberOfNodes()) {
+            return std::nullopt;
+        }
+        return original_id;
+    }
+
+    // the original ids are not sorted if the graph was permuted
+    auto iter = std::find(std::execution::par,
+                          std::begin(original_ids_),
+                          std::end(original_ids_),
+                          static_cast<std::uint64_t>(original_id));
+
+    if(iter == std::end(original_ids_)) {
+        return std::nullopt;
+    }
+    return static_cast<NodeId>(iter - std::begin(original_ids_));
+}
+
+auto Graph::getInternalIds() const
+    -> InternalIds
+{
+    InternalIds internal_ids;
+    internal_ids.number_of_nodes_ = getNumberOfNodes();
+    if(original_ids_.empty()) {
+        return internal_ids;
+    }
+    internal_ids.original_ids_ = {original_ids_.data(), original_ids_.size()};
+
+    // compacted ids are sorted, only permuted graphs need the order of their original ids
+    if(std::is_sorted(std::execution::par, std::begin(original_ids_), std::end(original_ids_))) {
+        return internal_ids;
+    }
+
+    auto& by_original_id = internal_ids.by_original_id_;
+    by_original_id.resize(original_ids_.size());
+    std::iota(std::begin(by_original_id), std::end(by_original_id), NodeId{0});
+    std::sort(std::execution::par,
+              std::begin(by_original_id),
+              std::end(by_original_id),
+              [&](auto lhs, auto rhs) {
+                  return original_ids_[lhs] < original_ids_[rhs];
+              });
+    return internal_ids;
+}
+
+auto InternalIds::find(NodeId original_id) const noexcept
+    -> std::optional<NodeId>
+{
+    if(original_id < 0) {
+        return std::nullopt;
+    }
+
+    if(original_ids_.empty()) {
+        if(original_id >= number_of_nodes_) {
+            return std::nullopt;
+        }
+        return original_id;
+    }
+
+    const auto id = static_cast<std::uint64_t>(original_id);
+    if(by_original_id_.empty()) {
+        auto iter = std::lower_bound(std::begin(original_ids_), std::end(original_ids_), id);
+        if(iter == std::end(original_ids_) or *iter != id) {
+            return std::nullopt;
+        }
+        return static_cast<NodeId>(iter - std::begin(original_ids_));
+    }
+
+    auto iter = std::lower_bound(std::begin(by_original_id_),
+                                 std::end(by_original_id_),
+                                 id,
+                                 [&](auto node, auto value) {
+                                     return original_ids_[node] < value;
+                                 });
+    if(iter == std::end(by_original_id_) or original_ids_[*iter] != id) {
+        return std::nullopt;
+    }
+    return *iter;
 }
@@ -1,5 +1,7 @@
 #include <CLI/CLI.hpp>
 #include <IMBProgramOptions.hpp>
+#include <fmt/core.h>
+#include <random>
 #include <thread>
 
 IMBProgramOptions::IMBProgramOptions(int reruns,
@@ -12,7 +14,16 @@ IMBProgramOptions::IMBProgramOptions(int reruns,
                                      bool use_inverse_graph,
                                      bool backwards_activation,
                                      bool random_edge_weights,
+                                     std::optional<float> uniform_probability,
+                                     bool relabel_ids,
+                                     ReorderStrategy reorder_strategy,
+                                     std::uint64_t seed,
+                                     std::optional<double> relative_error,
+                                     double confidence,
+                                     bool spread_curve,
+                                     std::optional<std::string> rr_set_path,
                                      std::optional<std::string> out_path,
+                                     std::optional<std::string> binary_out_path,
                                      std::vector<std::string> solver)
     : reruns_(static_cast<size_t>(reruns)),
       parse_mode_(parse_mode),
@@ -24,7 +35,16 @@ IMBProgramOptions::IMBProgramOptions(int reruns,
       use_inverse_graph_(use_inverse_graph),
       backwards_activation_(backwards_activation),
       random_edge_weights_(random_edge_weights),
+      uniform_probability_(uniform_probability),
+      relabel_ids_(relabel_ids),
+      reorder_strategy_(reorder_strategy),
+      seed_(seed),
+      relative_error_(relative_error),
+      confidence_(confidence),
+      spread_curve_(spread_curve),
+      rr_set_path_(std::move(rr_set_path)),
       out_path_(std::move(out_path)),
+      binary_out_path_(std::move(binary_out_path)),
       solver_(std::move(solver))
 {}
 
@@ -40,6 +60,12 @@ auto IMBProgramOptions::getSolvers() const
     return solver_;
 }
 
+auto IMBProgramOptions::getBinaryOutPath() const
+    -> const std::optional<std::string>&
+{
+    return binary_out_path_;
+}
+
 auto IMBProgramOptions::getGraphPath() const
     -> const std::string&
 {
@@ -90,11 +116,59 @@ auto IMBProgramOptions::shouldUseRandomEdgeWeights() const
     return random_edge_weights_;
 }
 
+auto IMBProgramOptions::getUniformProbability() const
+    -> const std::optional<float>&
+{
+    return uniform_probability_;
+}
+
+auto IMBProgramOptions::shouldRelabelIds() const
+    -> bool
+{
+    return relabel_ids_;
+}
+
+auto IMBProgramOptions::getReorderStrategy() const
+    -> ReorderStrategy
+{
+    return reorder_strategy_;
+}
+
+auto IMBProgramOptions::getSeed() const
+    -> std::uint64_t
+{
+    return seed_;
+}
+
+auto IMBProgramOptions::getRelativeError() const
+    -> const std::optional<double>&
+{
+    return relative_error_;
+}
+
+auto IMBProgramOptions::getConfidence() const
+    -> double
+{
+    return confidence_;
+}
+
+auto IMBProgramOptions::shouldEvaluateSpreadCurve() const
+    -> bool
+{
+    return spread_curve_;
+}
+
 auto IMBProgramOptions::shouldPerformBackwardsActivation()
     const -> bool
 {
     return backwards_activation_;
 }
+auto IMBProgramOptions::getRrSetPath() const
+    -> const std::optional<std::string>&
+{
+    return rr_set_path_;
+}
+
 auto IMBProgramOptions::getDiffusionModel() const -> DiffusionModel
 {
     return diffusion_model_;
@@ -107,15 +181,24 @@ auto parseArguments(int argc, char* argv[])
 
     std::string path;
     std::optional<std::string> out_path = std::nullopt;
+    std::optional<std::string> binary_out_path = std::nullopt;
     int threads = static_cast<int>(std::thread::hardware_concurrency());
     int seeds = 50;
     int reruns = 20000;
     bool print_raw = false;
     bool random_edge_weights = false;
+    std::optional<float> uniform_probability = std::nullopt;
+    bool relabel_ids = false;
     bool use_inverse = false;
     bool backwards_activation = false;
     ParseMode parse_mode = ParseMode::VERTEX_LIST;
     DiffusionModel diffusion_model = DiffusionModel::INDEPENDENT_CASCADE;
+    ReorderStrategy reorder_strategy = ReorderStrategy::NONE;
+    std::optional<std::uint64_t> seed = std::nullopt;
+    std::optional<double> relative_error = std::nullopt;
+    double confidence = 0.95;
+    bool spread_curve = false;
+    std::optional<std::string> rr_set_path = std::nullopt;
 
     std::vector<std::string> solvers;
 
@@ -126,12 +209,23 @@ auto parseArguments(int argc, char* argv[])
 
     app.add_option("-f,--format",
                    parse_mode,
-                   "format of the graph file (0=vertex list, 1=edge list)")
+                   "format of the graph file (0=vertex list, 1=edge list, 2=binary graph file)")
         ->required();
 
     app.add_option("-d,--diffusionModel",
                    diffusion_model,
-                   "Diffusion model to be used (0=IndependentCascade, 1=LinearThreshold). Default: Independent Cascade");
+                   "Diffusion model to be used (0=IndependentCascade, 1=LinearThreshold, 2=IndependentCascade bit parallel (64 simulations at once), "
+                   "3=IndependentCascade on live edge snapshots shared by all seed sets). Default: Independent Cascade");
+
+    app.add_option("--reorder",
+                   reorder_strategy,
+                   "renumbers the nodes after parsing to improve the memory locality "
+                   "(0=none, 1=degree, 2=reverse Cuthill-McKee, 3=community). Default: none");
+
+    app.add_option("--seed",
+                   seed,
+                   "seed of the random number generators, runs with the same seed and options are reproducible. "
+                   "Default: random");
 
     app.add_option("-o,--output",
                    out_path,
@@ -139,9 +233,27 @@ auto parseArguments(int argc, char* argv[])
 
     app.add_option("-s,--simulations",
                    reruns,
-                   "number of simulations performed in the independent cascade model for verification",
+                   "number of simulations performed in the independent cascade model for verification, "
+                   "the maximum number of simulations if --precision is set",
                    true);
 
+    app.add_option("--precision",
+                   relative_error,
+                   "adaptive evaluation: simulations are run until the confidence interval of the influence "
+                   "is within the given relative error (e.g. 0.01) or the simulations are exhausted")
+        ->check(CLI::PositiveNumber);
+
+    app.add_option("--confidence",
+                   confidence,
+                   "confidence level of the --precision interval",
+                   true)
+        ->check(CLI::Range(0.5, 0.999999));
+
+    app.add_option("--rr-sets",
+                   rr_set_path,
+                   "file in which IMM keeps its rr sets: stored rr sets are reused for any k, "
+                   "only missing rr sets are sampled and the file is updated afterwards");
+
     app.add_option("-t,--threads",
                    threads,
                    "number of threads used for the computations",
@@ -166,9 +278,13 @@ auto parseArguments(int argc, char* argv[])
                    "\t wd (weightedDegree) [recursion depth:int]\n"
                    "\t ipa (Influence Path Algorithm) [precision divider:int]\n"
                    "\t iterative-ua [recursion depth:int]\n")
-        ->required()
         ->delimiter(',');
 
+    app.add_option("-c,--convert",
+                   binary_out_path,
+                   "converter mode: writes the loaded graph as binary graph file to the given path and exits.\n"
+                   "The binary file can be loaded with format 2 using the same inverse and random edge weight flags");
+
     app.add_flag("-r, --print-raw",
                  print_raw,
                  "if set, the results will be printed non pretty and not formatted");
@@ -177,6 +293,20 @@ auto parseArguments(int argc, char* argv[])
                  random_edge_weights,
                  "if set, the weight of every edge will be one of {0.1, 0.01, 0.001} choosen randomly at the beginning");
 
+    app.add_option("--uniform-probability",
+                   uniform_probability,
+                   "if set, every edge has the given activation probability instead of the weights of the graph")
+        ->check(CLI::Range(0.0, 1.0));
+
+    app.add_flag("-l,--relabel-ids",
+                 relabel_ids,
+                 "if set, the node ids of the input file are compacted to 0..n-1 (useful for sparse ids).\n"
+                 "Seed sets are still written with the ids of the input file");
+
+    app.add_flag("--spread-curve",
+                 spread_curve,
+                 "if set, the forward influence of every prefix of the seed set (first 1, 2, ..., k seeds) is reported");
+
     app.add_flag("-i, --inverse",
                  use_inverse,
                  "if set, the inverse of the graph will be used");
@@ -191,6 +321,20 @@ auto parseArguments(int argc, char* argv[])
         std::exit(app.exit(e));
     }
 
+    // algorithms are only optional in converter mode
+    if(solvers.empty() and !binary_out_path) {
+        std::exit(app.exit(CLI::RequiredError("--algorithm")));
+    }
+
+    // use random_device to make sure the seed is different in every execution
+    // using time could result in the same seed, if the program is started multiple times within one second
+    if(!seed) {
+        std::random_device rd;
+        seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+        // stderr keeps the (raw) results on stdout unchanged, the run can be repeated with --seed
+        fmt::print(stderr, "random seed: {}\n", seed.value());
+    }
+
     return IMBProgramOptions{reruns,
                              parse_mode,
                              diffusion_model,
@@ -201,6 +345,15 @@ auto parseArguments(int argc, char* argv[])
                              use_inverse,
                              backwards_activation,
                              random_edge_weights,
+                             uniform_probability,
+                             relabel_ids,
+                             reorder_strategy,
+                             seed.value(),
+                             relative_error,
+                             confidence,
+                             spread_curve,
+                             std::move(rr_set_path),
                              std::move(out_path),
+                             std::move(binary_out_path),
                              std::move(solvers)};
 }
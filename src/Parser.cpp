@@ -1,79 +1,212 @@
 #include <Parser.hpp>
+#include <atomic>
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <execution>
 #include <fmt/core.h>
-#include <fstream>
-#include <iostream>
+#include <optional>
+#include <tbb/task_arena.h>
+#include <tuple>
 
 namespace {
 
-//extracts and erases the next integer from a string view
-auto extractNextInteger(std::string_view& line) noexcept
-    -> NodeId
+// part of a memory mapped text file, starts at the beginning of a line and ends after a newline (or at the end of the file)
+struct TextChunk
 {
-    if(auto remove = line.find_first_of("0123456789");
-       remove != std::string_view::npos) {
-        line.remove_prefix(remove);
-    }
+    const char* begin;
+    const char* end;
+};
+
+// splits the text into chunks of roughly equal size, all chunk borders are placed directly after a newline
+auto splitIntoChunks(const char* begin, const char* end)
+    -> std::vector<TextChunk>
+{
+    constexpr std::size_t min_chunk_size = 1 << 16;
+    const auto size = static_cast<std::size_t>(end - begin);
+    const auto threads = static_cast<std::size_t>(tbb::this_task_arena::max_concurrency());
+    // use more chunks than threads to balance lines of different lengths
+    const auto number_of_chunks = std::max<std::size_t>(1, std::min(threads * 4, size / min_chunk_size));
 
-    NodeId node = 0;
-    auto remove_counter = 0;
+    std::vector<TextChunk> chunks;
+    chunks.reserve(number_of_chunks);
 
-    // this can be optimized much more
-    for(char digit : line) {
-        if(digit == ':' || digit == ',' || std::isspace(digit)) {
-            break;
+    const auto* chunk_begin = begin;
+    for(std::size_t i = 1; i <= number_of_chunks and chunk_begin < end; ++i) {
+        const auto* chunk_end = begin + size * i / number_of_chunks;
+
+        if(chunk_end < chunk_begin) {
+            chunk_end = chunk_begin;
+        }
+        if(chunk_end < end) {
+            const auto* newline = static_cast<const char*>(std::memchr(chunk_end, '\n', end - chunk_end));
+            chunk_end = newline == nullptr ? end : newline + 1;
         }
 
-        node *= 10;
-        node += digit - '0';
-        remove_counter++;
+        chunks.push_back({chunk_begin, chunk_end});
+        chunk_begin = chunk_end;
     }
-    line.remove_prefix(remove_counter);
 
-    return node;
+    return chunks;
 }
 
-auto parseVertexListLine(std::string_view line)
-    -> std::tuple<NodeId, std::vector<Edge>>
+// calls func(line_begin, line_end) for every line of the chunk, line_end points to the newline (or the end of the chunk)
+template<class Func>
+auto forEachLine(TextChunk chunk, Func&& func)
+    -> void
 {
-    NodeId node = extractNextInteger(line);
+    const auto* line_begin = chunk.begin;
+    while(line_begin < chunk.end) {
+        const auto* newline = static_cast<const char*>(std::memchr(line_begin, '\n', chunk.end - line_begin));
+        const auto* line_end = newline == nullptr ? chunk.end : newline;
 
-    std::vector<Edge> edges;
+        func(line_begin, line_end);
 
-    while(!line.empty()) {
+        line_begin = line_end + 1;
+    }
+}
 
-        if(auto remove = line.find_first_of("0123456789");
-           remove != std::string_view::npos) {
-            line.remove_prefix(remove);
-        } else {
-            break;
-        }
+// moves pos to the next digit of the line, returns false if there is none
+auto skipToDigit(const char*& pos, const char* line_end) noexcept
+    -> bool
+{
+    while(pos < line_end and !std::isdigit(static_cast<unsigned char>(*pos))) {
+        ++pos;
+    }
+    return pos < line_end;
+}
+
+// parses the digits starting at pos and moves pos behind them
+auto parseDigits(const char*& pos, const char* line_end) noexcept
+    -> NodeId
+{
+    NodeId number = 0;
+    while(pos < line_end and std::isdigit(static_cast<unsigned char>(*pos))) {
+        number = number * 10 + (*pos - '0');
+        ++pos;
+    }
+    return number;
+}
+
+auto isCommentLine(const char* line_begin, const char* line_end) noexcept
+    -> bool
+{
+    return line_begin < line_end and (*line_begin == '#' or *line_begin == '%');
+}
 
+// maps the graph file into memory, skipping the meta data line if requested
+auto mapTextFile(std::string_view path, bool contains_meta_data)
+    -> std::tuple<util::MemoryMap, const char*, const char*>
+{
+    util::MemoryMap mapping{std::string{path}};
 
-        NodeId neighbour = extractNextInteger(line);
-        edges.emplace_back(neighbour, std::numeric_limits<float>::quiet_NaN());
+    if(!mapping.isValid()) {
+        fmt::print("Could not read file {}: {}\n", path, mapping.errorMessage());
+        std::exit(1);
     }
+    mapping.adviseSequential();
+
+    const auto* begin = mapping.data();
+    const auto* end = mapping.data() + mapping.size();
 
-    return {node, edges};
+    auto skip_line = [&] {
+        const auto* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        begin = newline == nullptr ? end : newline + 1;
+    };
+
+    if(contains_meta_data) {
+        // the meta data line is the first line which is not a comment
+        while(begin < end and isCommentLine(begin, end)) {
+            skip_line();
+        }
+        skip_line();
+    }
+
+    return {std::move(mapping), begin, end};
 }
 
-auto parseEdgeListLine(std::string_view line)
-    -> std::tuple<NodeId, NodeId, float>
+// parses an edge list line of the form "from to [weight]", returns nullopt for comments and lines without an edge
+auto parseEdgeListLine(const char* pos, const char* line_end) noexcept
+    -> std::optional<std::tuple<NodeId, NodeId, float>>
 {
-    NodeId from = extractNextInteger(line);
-    NodeId to = extractNextInteger(line);
+    if(isCommentLine(pos, line_end) or !skipToDigit(pos, line_end)) {
+        return std::nullopt;
+    }
+    auto from = parseDigits(pos, line_end);
 
-    char* end;
+    if(!skipToDigit(pos, line_end)) {
+        return std::nullopt;
+    }
+    auto to = parseDigits(pos, line_end);
 
-    float weight = std::strtof(line.data(), &end);
+    while(pos < line_end and (*pos == ' ' or *pos == '\t' or *pos == ',' or *pos == ';')) {
+        ++pos;
+    }
 
-    if(line.data() == end) {
-        weight = NAN;
+    float weight = std::numeric_limits<float>::quiet_NaN();
+    if(auto [end, error] = std::from_chars(pos, line_end, weight);
+       error != std::errc{}) {
+        weight = std::numeric_limits<float>::quiet_NaN();
     }
 
     return std::tuple{from, to, weight};
 }
 
+// relabels the ids of the flat edge arrays and the additional node ids to 0..n-1 (sort based compaction)
+// returns the sorted original ids, i.e. the original id of every new id
+auto compactIds(util::PackedArray& sources,
+                util::PackedArray& destinations,
+                util::PackedArray& additional_ids)
+    -> util::Buffer<std::uint64_t>
+{
+    const auto number_of_edges = sources.size();
+    const auto number_of_ids = 2 * number_of_edges + additional_ids.size();
+
+    util::Buffer<std::uint64_t> ids(number_of_ids);
+    const auto id_range = utils::range(number_of_ids);
+    std::for_each(std::execution::par,
+                  std::begin(id_range),
+                  std::end(id_range),
+                  [&](auto i) {
+                      if(i < number_of_edges) {
+                          ids[i] = sources.get(i);
+                      } else if(i < 2 * number_of_edges) {
+                          ids[i] = destinations.get(i - number_of_edges);
+                      } else {
+                          ids[i] = additional_ids.get(i - 2 * number_of_edges);
+                      }
+                  });
+
+    std::sort(std::execution::par, std::begin(ids), std::end(ids));
+    auto unique_end = std::unique(std::execution::par, std::begin(ids), std::end(ids));
+
+    util::Buffer<std::uint64_t> original_ids;
+    original_ids.assign(std::begin(ids), unique_end);
+    ids = {};
+
+    auto to_new_id = [&](std::uint64_t id) {
+        return static_cast<std::uint64_t>(std::lower_bound(std::as_const(original_ids).begin(),
+                                                           std::as_const(original_ids).end(),
+                                                           id)
+                                          - std::as_const(original_ids).begin());
+    };
+
+    std::for_each(std::execution::par,
+                  std::begin(id_range),
+                  std::end(id_range),
+                  [&](auto i) {
+                      if(i < number_of_edges) {
+                          sources.set(i, to_new_id(sources.get(i)));
+                      } else if(i < 2 * number_of_edges) {
+                          destinations.set(i - number_of_edges, to_new_id(destinations.get(i - number_of_edges)));
+                      } else {
+                          additional_ids.set(i - 2 * number_of_edges, to_new_id(additional_ids.get(i - 2 * number_of_edges)));
+                      }
+                  });
+
+    return original_ids;
+}
+
 } // namespace
 
 
@@ -81,44 +214,151 @@ auto parseVertexListFile(std::string_view path,
                          bool inverse,
                          bool contains_meta_data,
                          bool random_edge_weights,
+                         bool relabel_ids,
                          bool should_log)
     -> Graph
 {
     Graph graph{path.data()};
 
-    std::ifstream input_file(path.data(), std::ios::in);
-
-    if(!input_file) {
-        fmt::print("File {} not found\n", path);
-        std::exit(1);
-    }
-
-    std::string line;
-    bool first = true;
-    NodeId expected_node = 0;
+    auto [mapping, text_begin, text_end] = mapTextFile(path, contains_meta_data);
+    const auto chunks = splitIntoChunks(text_begin, text_end);
+    const auto chunk_range = utils::range(chunks.size());
+
+    struct ChunkStatistics
+    {
+        std::size_t lines = 0;
+        std::size_t edges = 0;
+        NodeId max_neighbour = -1;
+        NodeId max_node = -1;
+        // gaps between the node ids of consecutive lines within the chunk
+        std::size_t missing = 0;
+        NodeId first_node = -1;
+        NodeId last_node = -1;
+    };
+    std::vector<ChunkStatistics> statistics(chunks.size());
+
+    // first pass: count lines (nodes) and edges of every chunk
+    std::for_each(std::execution::par,
+                  std::begin(chunk_range),
+                  std::end(chunk_range),
+                  [&](auto chunk_id) {
+                      auto& stats = statistics[chunk_id];
+                      forEachLine(chunks[chunk_id], [&](const char* pos, const char* line_end) {
+                          // lines without any number (e.g. blank lines) are no nodes
+                          if(!skipToDigit(pos, line_end)) {
+                              return;
+                          }
+                          ++stats.lines;
+
+                          // the first number is the id of the node itself
+                          auto node = parseDigits(pos, line_end);
+                          if(stats.first_node < 0) {
+                              stats.first_node = node;
+                          } else if(node > stats.last_node + 1) {
+                              stats.missing += node - stats.last_node - 1;
+                          }
+                          stats.last_node = node;
+                          stats.max_node = std::max(stats.max_node, node);
+
+                          while(skipToDigit(pos, line_end)) {
+                              stats.max_neighbour = std::max(stats.max_neighbour, parseDigits(pos, line_end));
+                              ++stats.edges;
+                          }
+                      });
+                  });
+
+    // prefix sums over the chunks give the first node and edge of every chunk
+    std::vector<std::size_t> first_line(chunks.size() + 1, 0);
+    std::vector<std::size_t> first_edge(chunks.size() + 1, 0);
+    NodeId max_neighbour = -1;
+    NodeId max_node = -1;
     std::size_t missing = 0;
-
-    while(std::getline(input_file, line)) {
-
-        if(contains_meta_data) {
-            contains_meta_data = false;
-            continue;
-        }
-
-        auto [node, edges] = parseVertexListLine(line);
-
-        if(first and node != 0 and should_log) {
-            fmt::print("the edgelist file started with node {}, which is strange\n", node);
+    NodeId previous_node = -1;
+    for(auto chunk_id : chunk_range) {
+        const auto& stats = statistics[chunk_id];
+        first_line[chunk_id + 1] = first_line[chunk_id] + stats.lines;
+        first_edge[chunk_id + 1] = first_edge[chunk_id] + stats.edges;
+        max_neighbour = std::max(max_neighbour, stats.max_neighbour);
+        max_node = std::max(max_node, stats.max_node);
+
+        missing += stats.missing;
+        if(stats.lines > 0) {
+            if(stats.first_node > previous_node + 1) {
+                missing += stats.first_node - previous_node - 1;
+            }
+            previous_node = stats.last_node;
         }
+    }
 
-        first = false;
+    if(should_log and !relabel_ids and !chunks.empty() and statistics.front().first_node > 0) {
+        fmt::print("the edgelist file started with node {}, which is strange\n", statistics.front().first_node);
+    }
 
-        if(node != expected_node) {
-            missing += node - expected_node;
+    const auto number_of_lines = first_line.back();
+    const auto number_of_edges = first_edge.back();
+
+    if(relabel_ids) {
+        // the nodes are identified by the ids in the file instead of the line number,
+        // collect the edges with their original ids and compact the ids afterwards
+        const auto wide_ids = !util::PackedArray::fitsNarrow(std::max(max_node, max_neighbour));
+        util::PackedArray sources(number_of_edges, wide_ids);
+        util::PackedArray destinations(number_of_edges, wide_ids);
+        util::PackedArray line_ids(number_of_lines, wide_ids);
+
+        std::for_each(std::execution::par,
+                      std::begin(chunk_range),
+                      std::end(chunk_range),
+                      [&](auto chunk_id) {
+                          auto line = first_line[chunk_id];
+                          auto edge_pointer = first_edge[chunk_id];
+                          forEachLine(chunks[chunk_id], [&](const char* pos, const char* line_end) {
+                              if(!skipToDigit(pos, line_end)) {
+                                  return;
+                              }
+                              auto node = parseDigits(pos, line_end);
+                              line_ids.set(line++, node);
+
+                              while(skipToDigit(pos, line_end)) {
+                                  sources.set(edge_pointer, node);
+                                  destinations.set(edge_pointer++, parseDigits(pos, line_end));
+                              }
+                          });
+                      });
+
+        graph.original_ids_ = compactIds(sources, destinations, line_ids);
+        graph.buildForwardEdges(sources, destinations, {}, graph.original_ids_.size());
+    } else {
+        // neighbours without an own line are appended as nodes without out-edges
+        const auto number_of_nodes = std::max<std::size_t>(number_of_lines, max_neighbour + 1);
+
+        auto& forward = graph.forward_;
+        forward.offsets = util::PackedArray(number_of_nodes + 1, !util::PackedArray::fitsNarrow(number_of_edges));
+        forward.destinations = util::PackedArray(number_of_edges, !util::PackedArray::fitsNarrow(number_of_nodes));
+
+        // second pass: write offsets and destinations directly into the CSR arrays
+        std::for_each(std::execution::par,
+                      std::begin(chunk_range),
+                      std::end(chunk_range),
+                      [&](auto chunk_id) {
+                          auto node = first_line[chunk_id];
+                          auto edge_pointer = first_edge[chunk_id];
+                          forEachLine(chunks[chunk_id], [&](const char* pos, const char* line_end) {
+                              if(!skipToDigit(pos, line_end)) {
+                                  return;
+                              }
+                              parseDigits(pos, line_end);
+
+                              while(skipToDigit(pos, line_end)) {
+                                  forward.destinations.set(edge_pointer++, parseDigits(pos, line_end));
+                              }
+
+                              forward.offsets.set(++node, edge_pointer);
+                          });
+                      });
+
+        for(auto n = number_of_lines + 1; n <= number_of_nodes; ++n) {
+            forward.offsets.set(n, number_of_edges);
         }
-        expected_node = node + 1;
-
-        graph.appendNode(node, edges);
     }
 
     if(random_edge_weights) {
@@ -135,7 +375,8 @@ auto parseVertexListFile(std::string_view path,
     }
 
 
-    if(missing != 0 and should_log) {
+    // gaps in the ids are expected when relabeling
+    if(missing != 0 and should_log and !relabel_ids) {
         fmt::print("while parsing the graph, {} nodes were missing\n", missing);
     }
 
@@ -146,47 +387,89 @@ auto parseEdgeListFile(std::string_view path,
                        bool inverse,
                        bool contains_meta_data,
                        bool random_edge_weights,
+                       bool relabel_ids,
                        bool should_log)
     -> Graph
 {
-    std::unordered_map<NodeId, std::vector<Edge>> adj_list;
-
-    std::ifstream input_file(path.data(), std::ios::in);
-
-    if(!input_file) {
-        fmt::print("File {} not found\n", path);
-        std::exit(1);
-    }
-
-    std::string line;
+    Graph graph{path.data()};
 
+    auto [mapping, text_begin, text_end] = mapTextFile(path, contains_meta_data);
+    const auto chunks = splitIntoChunks(text_begin, text_end);
+    const auto chunk_range = utils::range(chunks.size());
+
+    struct ChunkStatistics
+    {
+        std::size_t edges = 0;
+        NodeId max = 0;
+        bool has_weights = false;
+    };
+    std::vector<ChunkStatistics> statistics(chunks.size());
+
+    // first pass: count the edges of every chunk and find the largest id
+    std::for_each(std::execution::par,
+                  std::begin(chunk_range),
+                  std::end(chunk_range),
+                  [&](auto chunk_id) {
+                      auto& stats = statistics[chunk_id];
+                      forEachLine(chunks[chunk_id], [&](const char* line_begin, const char* line_end) {
+                          if(auto edge = parseEdgeListLine(line_begin, line_end)) {
+                              auto [from, to, weight] = edge.value();
+                              ++stats.edges;
+                              stats.max = std::max({stats.max, from, to});
+                              stats.has_weights |= !std::isnan(weight);
+                          }
+                      });
+                  });
+
+    std::vector<std::size_t> first_edge(chunks.size() + 1, 0);
     NodeId max{0};
-
-    while(std::getline(input_file, line)) {
-        if(line.rfind('#', 0) == 0
-           or line.rfind('%', 0) == 0
-           or contains_meta_data) {
-            contains_meta_data = false;
-            continue;
-        }
-
-        auto [from, to, weight] = parseEdgeListLine(line);
-
-        adj_list[from].emplace_back(to, weight);
-
-        max = std::max(max, from);
-        max = std::max(max, to);
+    bool has_weights = false;
+    for(auto chunk_id : chunk_range) {
+        first_edge[chunk_id + 1] = first_edge[chunk_id] + statistics[chunk_id].edges;
+        max = std::max(max, statistics[chunk_id].max);
+        has_weights |= statistics[chunk_id].has_weights;
     }
 
-    Graph graph{path.data()};
-    for(NodeId n{0}; n <= max; n++) {
-        if(adj_list.find(n) == adj_list.end()) {
-            graph.appendNode(n, {});
-        } else {
-            graph.appendNode(n, std::move(adj_list[n]));
-        }
+    const auto number_of_edges = first_edge.back();
+    const auto wide_ids = !util::PackedArray::fitsNarrow(max);
+
+    // second pass: parse the edges into flat arrays,
+    // the weights are only kept if the file contains any
+    util::PackedArray sources(number_of_edges, wide_ids);
+    util::PackedArray destinations(number_of_edges, wide_ids);
+    util::Buffer<float> weights(has_weights ? number_of_edges : 0);
+
+    std::for_each(std::execution::par,
+                  std::begin(chunk_range),
+                  std::end(chunk_range),
+                  [&](auto chunk_id) {
+                      auto edge_pointer = first_edge[chunk_id];
+                      forEachLine(chunks[chunk_id], [&](const char* line_begin, const char* line_end) {
+                          if(auto edge = parseEdgeListLine(line_begin, line_end)) {
+                              auto [from, to, weight] = edge.value();
+                              sources.set(edge_pointer, from);
+                              destinations.set(edge_pointer, to);
+                              if(has_weights) {
+                                  weights[edge_pointer] = weight;
+                              }
+                              ++edge_pointer;
+                          }
+                      });
+                  });
+
+    auto number_of_nodes = static_cast<std::size_t>(max) + 1;
+    if(relabel_ids) {
+        util::PackedArray no_additional_ids;
+        graph.original_ids_ = compactIds(sources, destinations, no_additional_ids);
+        number_of_nodes = graph.original_ids_.size();
     }
 
+    graph.buildForwardEdges(sources, destinations, weights, number_of_nodes);
+
+    // free the flat arrays before the backward edges are build
+    sources = {};
+    destinations = {};
+    weights = {};
 
     if(random_edge_weights) {
         graph.assignRandomForwardEdgeWeights();
@@ -202,8 +485,10 @@ auto parseEdgeListFile(std::string_view path,
     }
 
     if(should_log) {
-        auto isolated = std::count_if(std::begin(utils::range(max)),
-                                      std::end(utils::range(max)),
+        auto nodes = graph.getNodes();
+        auto isolated = std::count_if(std::execution::par,
+                                      std::begin(nodes),
+                                      std::end(nodes),
                                       [&](auto n) {
                                           return graph.getEdgesOf(n).empty()
                                               and graph.getInverseEdgesOf(n).empty();
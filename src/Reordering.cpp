@@ -0,0 +1,220 @@
+#include <Reordering.hpp>
+#include <Timer.h>
+#include <algorithm>
+#include <execution>
+#include <fmt/core.h>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+auto undirectedDegrees(const Graph& graph)
+    -> std::vector<std::int64_t>
+{
+    const auto nodes = graph.getNodes();
+    std::vector<std::int64_t> degrees(graph.getNumberOfNodes());
+
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto n) {
+                      degrees[n] = graph.getOutDegreeOf(n) + graph.getInDegreeOf(n);
+                  });
+
+    return degrees;
+}
+
+auto identityOrder(const Graph& graph)
+    -> std::vector<NodeId>
+{
+    std::vector<NodeId> order(graph.getNumberOfNodes());
+    std::iota(std::begin(order),
+              std::end(order),
+              0);
+    return order;
+}
+
+// calls func for every neighbour of the node, ignoring the edge directions
+template<class Func>
+auto forEachNeighbour(const Graph& graph, NodeId node, Func&& func)
+    -> void
+{
+    for(auto e : graph.getEdgesOf(node)) {
+        func(e.getDestination());
+    }
+    for(auto e : graph.getInverseEdgesOf(node)) {
+        func(e.getDestination());
+    }
+}
+
+constexpr std::size_t MAX_LABEL_PROPAGATION_ROUNDS = 20;
+
+} // namespace
+
+auto computeDegreeOrder(const Graph& graph)
+    -> std::vector<NodeId>
+{
+    const auto degrees = undirectedDegrees(graph);
+    auto order = identityOrder(graph);
+
+    std::stable_sort(std::execution::par,
+                     std::begin(order),
+                     std::end(order),
+                     [&](auto lhs, auto rhs) {
+                         return degrees[lhs] > degrees[rhs];
+                     });
+
+    return order;
+}
+
+auto computeRcmOrder(const Graph& graph)
+    -> std::vector<NodeId>
+{
+    const auto degrees = undirectedDegrees(graph);
+    const auto number_of_nodes = graph.getNumberOfNodes();
+
+    // every connected component starts with its node of minimal degree
+    auto start_nodes = identityOrder(graph);
+    std::stable_sort(std::execution::par,
+                     std::begin(start_nodes),
+                     std::end(start_nodes),
+                     [&](auto lhs, auto rhs) {
+                         return degrees[lhs] < degrees[rhs];
+                     });
+
+    std::vector<NodeId> order;
+    order.reserve(number_of_nodes);
+    std::vector<bool> visited(number_of_nodes, false);
+    std::vector<NodeId> neighbours;
+
+    for(auto start : start_nodes) {
+        if(visited[start]) {
+            continue;
+        }
+
+        visited[start] = true;
+        order.emplace_back(start);
+
+        // the order vector itself is the bfs queue
+        for(auto head = order.size() - 1; head < order.size(); ++head) {
+            neighbours.clear();
+            forEachNeighbour(graph, order[head], [&](auto neighbour) {
+                if(!visited[neighbour]) {
+                    visited[neighbour] = true;
+                    neighbours.emplace_back(neighbour);
+                }
+            });
+
+            std::sort(std::begin(neighbours),
+                      std::end(neighbours),
+                      [&](auto lhs, auto rhs) {
+                          return std::pair{degrees[lhs], lhs} < std::pair{degrees[rhs], rhs};
+                      });
+
+            order.insert(std::end(order),
+                         std::begin(neighbours),
+                         std::end(neighbours));
+        }
+    }
+
+    std::reverse(std::begin(order), std::end(order));
+    return order;
+}
+
+auto computeCommunityOrder(const Graph& graph)
+    -> std::vector<NodeId>
+{
+    const auto degrees = undirectedDegrees(graph);
+    const auto number_of_nodes = static_cast<std::size_t>(graph.getNumberOfNodes());
+
+    // label propagation: every node takes the most frequent label of its neighbours.
+    // The nodes are updated in place and in id order, which keeps the result deterministic
+    auto labels = identityOrder(graph);
+    std::vector<NodeId> neighbour_labels;
+
+    for(std::size_t round = 0; round < MAX_LABEL_PROPAGATION_ROUNDS; ++round) {
+        std::size_t changed = 0;
+
+        for(std::size_t node = 0; node < number_of_nodes; ++node) {
+            neighbour_labels.clear();
+            forEachNeighbour(graph, node, [&](auto neighbour) {
+                neighbour_labels.emplace_back(labels[neighbour]);
+            });
+
+            if(neighbour_labels.empty()) {
+                continue;
+            }
+
+            std::sort(std::begin(neighbour_labels), std::end(neighbour_labels));
+
+            // find the most frequent label, the current label wins ties
+            auto best_label = labels[node];
+            std::size_t best_count = std::count(std::begin(neighbour_labels),
+                                                std::end(neighbour_labels),
+                                                best_label);
+            for(auto iter = std::begin(neighbour_labels); iter != std::end(neighbour_labels);) {
+                auto run_end = std::upper_bound(iter, std::end(neighbour_labels), *iter);
+                auto count = static_cast<std::size_t>(run_end - iter);
+                if(count > best_count) {
+                    best_count = count;
+                    best_label = *iter;
+                }
+                iter = run_end;
+            }
+
+            if(best_label != labels[node]) {
+                labels[node] = best_label;
+                ++changed;
+            }
+        }
+
+        // stop if less than 0.1% of the nodes changed their community
+        if(changed * 1000 < number_of_nodes) {
+            break;
+        }
+    }
+
+    // the nodes of a community are placed next to each other, hubs of the community first
+    auto order = identityOrder(graph);
+    std::sort(std::execution::par,
+              std::begin(order),
+              std::end(order),
+              [&](auto lhs, auto rhs) {
+                  return std::tuple{labels[lhs], -degrees[lhs], lhs}
+                  < std::tuple{labels[rhs], -degrees[rhs], rhs};
+              });
+
+    return order;
+}
+
+auto reorderGraph(Graph& graph,
+                  ReorderStrategy strategy,
+                  bool should_log)
+    -> void
+{
+    if(strategy == ReorderStrategy::NONE) {
+        return;
+    }
+
+    Timer timer;
+
+    auto order = [&] {
+        switch(strategy) {
+        case ReorderStrategy::DEGREE:
+            return computeDegreeOrder(graph);
+        case ReorderStrategy::RCM:
+            return computeRcmOrder(graph);
+        case ReorderStrategy::COMMUNITY:
+            return computeCommunityOrder(graph);
+        default:
+            fmt::print("unknown reorder strategy\n");
+            std::exit(-1);
+        }
+    }();
+
+    graph.permute(order);
+
+    if(should_log) {
+        fmt::print("reordered the nodes of the graph in {:.2f}s\n", timer.elapsed());
+    }
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <cmath>
+#include <diffusion/AdaptiveEvaluation.hpp>
+
+namespace {
+
+// smallest batch, keeps all threads busy and the variance estimate of the first batch stable
+constexpr std::size_t MIN_BATCH_SIZE = 1024;
+
+/**
+ * @return z such that a standard normal variable lies within [-z, z] with the given probability
+ */
+auto normalQuantile(double confidence) noexcept
+    -> double
+{
+    const auto tail = (1.0 - confidence) / 2.0;
+
+    // bisection on the upper tail probability, which is decreasing in z
+    double low = 0.0;
+    double high = 40.0;
+    for(int i = 0; i < 100; ++i) {
+        const auto mid = (low + high) / 2.0;
+        if(0.5 * std::erfc(mid / std::sqrt(2.0)) > tail) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+
+    return (low + high) / 2.0;
+}
+
+} // namespace
+
+auto estimateInfluence(const DiffusionModelInterface& model,
+                       const std::vector<NodeId>& seeds,
+                       bool backward,
+                       const PrecisionTarget& target) noexcept
+    -> InfluenceEstimate
+{
+    const auto z = normalQuantile(target.confidence);
+
+    util::RunningStatistics statistics;
+    auto batch_size = std::min(MIN_BATCH_SIZE, target.max_simulations);
+
+    while(batch_size > 0) {
+        statistics.merge(backward
+                             ? model.sampleBackwardN(seeds, batch_size)
+                             : model.sampleForwardN(seeds, batch_size));
+
+        const auto half_width = z * statistics.standardError();
+        const auto allowed_half_width = target.relative_error * statistics.mean();
+        if(half_width <= allowed_half_width) {
+            break;
+        }
+
+        // the half width shrinks with 1/sqrt(n), hence the number of needed simulations can be predicted
+        const auto remaining = target.max_simulations - statistics.count();
+        const auto needed = allowed_half_width > 0.0
+            ? std::pow(half_width / allowed_half_width, 2.0) * static_cast<double>(statistics.count())
+            : static_cast<double>(target.max_simulations);
+        const auto missing = std::min(needed - static_cast<double>(statistics.count()),
+                                      static_cast<double>(remaining));
+
+        batch_size = std::min(std::max(static_cast<std::size_t>(std::ceil(missing)), MIN_BATCH_SIZE),
+                              remaining);
+    }
+
+    return {statistics.mean(),
+            z * statistics.standardError(),
+            statistics.count()};
+}
@@ -0,0 +1,145 @@
+#include <diffusion/BitParallelCascade.hpp>
+#include <diffusion/WorldPropagation.hpp>
+#include <execution>
+
+using utils::range;
+using bitparallel::WORLDS_PER_MASK;
+
+BitParallelCascader::BitParallelCascader(const Graph& graph) noexcept
+    : graph_(graph) {}
+
+auto BitParallelCascader::cascadeWorlds(const std::vector<NodeId>& seeds,
+                                        std::uint64_t worlds,
+                                        bool backward,
+                                        util::RandomGenerator& generator,
+                                        util::RunningStatistics* per_world) const noexcept
+    -> std::size_t
+{
+    return bitparallel::propagateWorlds(
+        graph_,
+        seeds,
+        worlds,
+        backward,
+        [&](const auto& edge, auto /* edge_index */, auto candidates) {
+            return bitparallel::drawLiveWorlds(edge.getWeight(), candidates, generator);
+        },
+        per_world);
+}
+
+auto BitParallelCascader::cascadeN(const std::vector<NodeId>& seeds,
+                                   std::size_t n,
+                                   bool backward) const noexcept
+    -> double
+{
+    const auto family = util::RandomService::newStreamFamily();
+    const auto batches = (n + WORLDS_PER_MASK - 1) / WORLDS_PER_MASK;
+
+    return std::transform_reduce(
+        std::execution::par,
+        std::begin(range(batches)),
+        std::end(range(batches)),
+        0.0,
+        [](auto acc, auto current) {
+            return acc + current;
+        },
+        [&](auto batch) {
+            // the last batch only uses the remaining worlds
+            const auto worlds = bitparallel::firstWorlds(n - batch * WORLDS_PER_MASK);
+
+            auto generator = util::RandomService::stream(family, batch);
+            return cascadeWorlds(seeds, worlds, backward, generator)
+                / static_cast<double>(n);
+        });
+}
+
+auto BitParallelCascader::sampleN(const std::vector<NodeId>& seeds,
+                                  std::size_t n,
+                                  bool backward) const noexcept
+    -> util::RunningStatistics
+{
+    const auto family = util::RandomService::newStreamFamily();
+    const auto batches = (n + WORLDS_PER_MASK - 1) / WORLDS_PER_MASK;
+
+    return std::transform_reduce(
+        std::execution::par,
+        std::begin(range(batches)),
+        std::end(range(batches)),
+        util::RunningStatistics{},
+        [](auto acc, const auto& current) {
+            acc.merge(current);
+            return acc;
+        },
+        [&](auto batch) {
+            const auto worlds = bitparallel::firstWorlds(n - batch * WORLDS_PER_MASK);
+
+            auto generator = util::RandomService::stream(family, batch);
+            util::RunningStatistics statistics;
+            cascadeWorlds(seeds, worlds, backward, generator, &statistics);
+            return statistics;
+        });
+}
+
+auto BitParallelCascader::cascadeForwardN(const std::vector<NodeId>& seeds,
+                                          std::size_t n) const noexcept
+    -> double
+{
+    return cascadeN(seeds, n, false);
+}
+
+auto BitParallelCascader::cascadeBackwardN(const std::vector<NodeId>& seeds,
+                                           std::size_t n) const noexcept
+    -> double
+{
+    return cascadeN(seeds, n, true);
+}
+
+auto BitParallelCascader::sampleForwardN(const std::vector<NodeId>& seeds,
+                                         std::size_t n) const noexcept
+    -> util::RunningStatistics
+{
+    return sampleN(seeds, n, false);
+}
+
+auto BitParallelCascader::sampleBackwardN(const std::vector<NodeId>& seeds,
+                                          std::size_t n) const noexcept
+    -> util::RunningStatistics
+{
+    return sampleN(seeds, n, true);
+}
+
+auto BitParallelCascader::cascadeForwardCurveN(const std::vector<NodeId>& seeds,
+                                               std::size_t n) const noexcept
+    -> std::vector<double>
+{
+    const auto family = util::RandomService::newStreamFamily();
+    const auto batches = (n + WORLDS_PER_MASK - 1) / WORLDS_PER_MASK;
+
+    return std::transform_reduce(
+        std::execution::par,
+        std::begin(range(batches)),
+        std::end(range(batches)),
+        std::vector<double>(seeds.size(), 0.0),
+        [](auto acc, const auto& current) {
+            std::transform(std::begin(acc), std::end(acc), std::begin(current), std::begin(acc), std::plus<>{});
+            return acc;
+        },
+        [&](auto batch) {
+            const auto worlds = bitparallel::firstWorlds(n - batch * WORLDS_PER_MASK);
+
+            auto generator = util::RandomService::stream(family, batch);
+            const auto activated = bitparallel::propagateWorldsCurve(
+                graph_,
+                seeds,
+                worlds,
+                false,
+                [&](const auto& edge, auto /* edge_index */, auto candidates) {
+                    return bitparallel::drawLiveWorlds(edge.getWeight(), candidates, generator);
+                });
+
+            std::vector<double> curve(seeds.size());
+            std::transform(std::begin(activated), std::end(activated), std::begin(curve), [&](auto count) {
+                return count / static_cast<double>(n);
+            });
+            return curve;
+        });
+}
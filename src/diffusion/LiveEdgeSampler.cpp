@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <diffusion/LiveEdgeSampler.hpp>
+#include <execution>
+#include <numeric>
+
+using utils::range;
+
+LiveEdgeSampler::LiveEdgeSampler(const Graph& graph, bool backward)
+    : graph_(graph),
+      backward_(backward),
+      run_offsets_(graph.getNumberOfNodes() + 1, 0)
+{
+    const auto edges_of = [&](auto node) {
+        return backward ? graph.getInverseEdgesOf(node) : graph.getEdgesOf(node);
+    };
+    const auto first_edge_of = [&](auto node) {
+        return backward ? graph.getInverseEdgeOffsetOf(node) : graph.getEdgeOffsetOf(node);
+    };
+    const auto nodes = range(graph.getNumberOfNodes());
+
+    // the probabilities of the edges of a node in descending order
+    const auto sorted_probabilities = [&](auto node) -> std::vector<float>& {
+        thread_local std::vector<float> probabilities;
+        probabilities.clear();
+        for(const auto& edge : edges_of(node)) {
+            probabilities.emplace_back(edge.getWeight());
+        }
+        std::sort(std::begin(probabilities), std::end(probabilities), std::greater<>{});
+        return probabilities;
+    };
+
+    // every distinct probability of a node is one group
+    std::for_each(
+        std::execution::par,
+        std::begin(nodes),
+        std::end(nodes),
+        [&](auto node) {
+            auto& probabilities = sorted_probabilities(node);
+            const auto distinct = std::unique(std::begin(probabilities), std::end(probabilities))
+                - std::begin(probabilities);
+            run_offsets_[node + 1] = static_cast<std::size_t>(distinct);
+        });
+    const auto multiple_groups = std::any_of(std::execution::par,
+                                             std::begin(run_offsets_),
+                                             std::end(run_offsets_),
+                                             [](auto groups) { return groups > 1; });
+    std::inclusive_scan(std::begin(run_offsets_), std::end(run_offsets_), std::begin(run_offsets_));
+
+    const auto number_of_groups = run_offsets_.back();
+    if(static_cast<double>(graph.getNumberOfEdges()) < MIN_AVERAGE_GROUP_SIZE * static_cast<double>(number_of_groups)) {
+        run_offsets_.clear();
+        return;
+    }
+    grouped_ = true;
+    reordered_ = multiple_groups;
+
+    runs_.resize(number_of_groups + 1);
+    runs_.back().begin = graph.getNumberOfEdges();
+
+    const auto make_run = [](std::size_t begin, float probability) {
+        return Run{begin, probability, static_cast<float>(1.0 / std::log1p(-static_cast<double>(probability)))};
+    };
+
+    // the edges of the graph are already in group order if every node has a single group (e.g. uniform weights)
+    if(!reordered_) {
+        std::for_each(
+            std::execution::par,
+            std::begin(nodes),
+            std::end(nodes),
+            [&](auto node) {
+                const auto edges = edges_of(node);
+                if(edges.size() > 0) {
+                    runs_[run_offsets_[node]] = make_run(first_edge_of(node), edges[0].getWeight());
+                }
+            });
+        return;
+    }
+
+    destinations_ = util::PackedArray(graph.getNumberOfEdges(), !util::PackedArray::fitsNarrow(graph.getNumberOfNodes()));
+
+    // the edges of every node are sorted by probability in place of their index range
+    std::for_each(
+        std::execution::par,
+        std::begin(nodes),
+        std::end(nodes),
+        [&](auto node) {
+            const auto edges = edges_of(node);
+            thread_local std::vector<std::size_t> order;
+            order.resize(edges.size());
+            std::iota(std::begin(order), std::end(order), std::size_t{0});
+            std::stable_sort(std::begin(order), std::end(order), [&](auto lhs, auto rhs) {
+                return edges[lhs].getWeight() > edges[rhs].getWeight();
+            });
+
+            const auto first = first_edge_of(node);
+            auto run = run_offsets_[node];
+            for(std::size_t i = 0; i < order.size(); ++i) {
+                const auto& edge = edges[order[i]];
+                destinations_.set(first + i, static_cast<std::uint64_t>(edge.getDestination()));
+
+                const auto probability = edge.getWeight();
+                if(i == 0 or probability != edges[order[i - 1]].getWeight()) {
+                    runs_[run++] = make_run(first + i, probability);
+                }
+            }
+        });
+}
@@ -0,0 +1,96 @@
+#include <diffusion/LiveInEdgeSampler.hpp>
+#include <execution>
+
+LiveInEdgeSampler::LiveInEdgeSampler(const Graph& graph)
+    : graph_(graph),
+      nodes_(graph.getNumberOfNodes())
+{
+    const auto nodes = graph.getNodes();
+
+    graph.visitEdges(true, [&](auto edges_of) {
+        std::for_each(
+            std::execution::par,
+            std::begin(nodes),
+            std::end(nodes),
+            [&](auto node) {
+                const auto in_edges = edges_of(node);
+                auto& sampled = nodes_[node];
+                sampled.size = static_cast<std::uint32_t>(in_edges.size());
+
+                double sum = 0.0;
+                for(const auto& edge : in_edges) {
+                    sum += std::max(0.0, static_cast<double>(edge.getWeight()));
+                    sampled.equal_weights = sampled.equal_weights and edge.getWeight() == in_edges[0].getWeight();
+                }
+                sampled.total = std::min(sum, 1.0);
+            });
+
+        const auto needs_alias_tables = std::any_of(std::begin(nodes_), std::end(nodes_), [](const auto& in_edges) {
+            return !in_edges.equal_weights;
+        });
+        if(!needs_alias_tables) {
+            return;
+        }
+
+        acceptance_.resize(graph.getNumberOfEdges());
+        aliases_.resize(graph.getNumberOfEdges());
+
+        // alias tables (Vose): every slot keeps its own edge with the acceptance probability, otherwise it takes its alias
+        std::for_each(
+            std::execution::par,
+            std::begin(nodes),
+            std::end(nodes),
+            [&](auto node) {
+                // nodes without positive weights are never sampled
+                if(nodes_[node].equal_weights or nodes_[node].total <= 0.0) {
+                    return;
+                }
+
+                const auto in_edges = edges_of(node);
+                const auto first = graph.getInverseEdgeOffsetOf(node);
+                const auto size = in_edges.size();
+
+                thread_local std::vector<double> scaled;
+                thread_local std::vector<std::uint32_t> small;
+                thread_local std::vector<std::uint32_t> large;
+                scaled.clear();
+                small.clear();
+                large.clear();
+
+                double sum = 0.0;
+                for(const auto& edge : in_edges) {
+                    sum += std::max(0.0, static_cast<double>(edge.getWeight()));
+                }
+
+                for(std::uint32_t i = 0; i < size; ++i) {
+                    scaled.emplace_back(std::max(0.0, static_cast<double>(in_edges[i].getWeight())) / sum * static_cast<double>(size));
+                    (scaled.back() < 1.0 ? small : large).emplace_back(i);
+                }
+
+                while(!small.empty() and !large.empty()) {
+                    const auto less = small.back();
+                    small.pop_back();
+                    const auto more = large.back();
+
+                    acceptance_[first + less] = static_cast<float>(scaled[less]);
+                    aliases_[first + less] = more;
+
+                    scaled[more] -= 1.0 - scaled[less];
+                    if(scaled[more] < 1.0) {
+                        large.pop_back();
+                        small.emplace_back(more);
+                    }
+                }
+
+                // the remaining slots are full up to rounding errors
+                for(auto i : small) {
+                    acceptance_[first + i] = 1.0f;
+                    aliases_[first + i] = i;
+                }
+                for(auto i : large) {
+                    acceptance_[first + i] = 1.0f;
+                    aliases_[first + i] = i;
+                }
+            });
+    });
+}
@@ -0,0 +1,218 @@
+#include <diffusion/SnapshotCascade.hpp>
+#include <diffusion/WorldPropagation.hpp>
+#include <execution>
+#include <fmt/core.h>
+#include <limits>
+#include <new>
+#include <tbb/task_arena.h>
+#include <unistd.h>
+
+using utils::range;
+using bitparallel::WORLDS_PER_MASK;
+
+namespace {
+
+/**
+ * @return a quarter of the physical memory, one pool per edge direction may use it
+ */
+auto poolMemoryLimit() noexcept
+    -> std::size_t
+{
+    const auto pages = ::sysconf(_SC_PHYS_PAGES);
+    const auto page_size = ::sysconf(_SC_PAGE_SIZE);
+    if(pages <= 0 or page_size <= 0) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return static_cast<std::size_t>(pages) / 4 * static_cast<std::size_t>(page_size);
+}
+
+} // namespace
+
+SnapshotCascader::SnapshotCascader(const Graph& graph) noexcept
+    : graph_(graph),
+      max_pool_bytes_(poolMemoryLimit()),
+      fresh_worlds_(graph)
+{
+    forward_pool_.family = util::RandomService::newStreamFamily();
+    backward_pool_.family = util::RandomService::newStreamFamily();
+}
+
+auto SnapshotCascader::growPool(SnapshotPool& pool,
+                                std::size_t number_of_batches,
+                                bool backward) const noexcept
+    -> std::optional<std::vector<const std::uint64_t*>>
+{
+    std::lock_guard lock{pool.mutex};
+
+    const auto old_size = pool.batches.size();
+    const auto edges = static_cast<std::size_t>(graph_.getNumberOfEdges());
+    const auto batch_bytes = edges * sizeof(std::uint64_t);
+    const auto fits = batch_bytes == 0 or number_of_batches <= max_pool_bytes_ / batch_bytes;
+
+    // the memory is allocated before the parallel sampling, hence running out of it is not fatal
+    if(old_size < number_of_batches and fits) {
+        try {
+            pool.batches.reserve(number_of_batches);
+            for(auto batch = old_size; batch < number_of_batches; ++batch) {
+                pool.batches.emplace_back(std::make_unique_for_overwrite<std::uint64_t[]>(edges));
+            }
+        } catch(const std::bad_alloc&) {
+            pool.batches.resize(old_size);
+        }
+    }
+
+    if(pool.batches.size() < number_of_batches) {
+        if(!pool.reported_limit) {
+            fmt::print(stderr,
+                       "snapshot pool of {} worlds needs {:.2f} GB per edge direction (limit {:.2f} GB), "
+                       "larger evaluations simulate fresh worlds\n",
+                       number_of_batches * WORLDS_PER_MASK,
+                       static_cast<double>(number_of_batches) * static_cast<double>(batch_bytes) / 1e9,
+                       static_cast<double>(max_pool_bytes_) / 1e9);
+            pool.reported_limit = true;
+        }
+        return std::nullopt;
+    }
+
+    // the thread holding the mutex must not pick up another evaluation while it waits for the sampling,
+    // which would lock the mutex a second time
+    tbb::this_task_arena::isolate([&] {
+        std::for_each(
+            std::execution::par,
+            std::begin(range(old_size, number_of_batches)),
+            std::end(range(old_size, number_of_batches)),
+            [&](auto batch) {
+                // the worlds of a batch only depend on the pool and the batch index
+                auto generator = util::RandomService::stream(pool.family, batch);
+                auto* live_worlds = pool.batches[batch].get();
+
+                for(auto node : graph_.getNodes()) {
+                    const auto edges = backward
+                        ? graph_.getInverseEdgesOf(node)
+                        : graph_.getEdgesOf(node);
+                    const auto first_edge = backward
+                        ? graph_.getInverseEdgeOffsetOf(node)
+                        : graph_.getEdgeOffsetOf(node);
+
+                    for(std::size_t i = 0; i < edges.size(); ++i) {
+                        live_worlds[first_edge + i] =
+                            bitparallel::drawLiveWorlds(edges[i].getWeight(), ~std::uint64_t{0}, generator);
+                    }
+                }
+            });
+    });
+
+    std::vector<const std::uint64_t*> batches(number_of_batches);
+    std::transform(std::begin(pool.batches),
+                   std::begin(pool.batches) + static_cast<std::ptrdiff_t>(number_of_batches),
+                   std::begin(batches),
+                   [](const auto& batch) { return batch.get(); });
+    return batches;
+}
+
+auto SnapshotCascader::cascadeN(const std::vector<NodeId>& seeds,
+                                std::size_t n,
+                                bool backward) const noexcept
+    -> double
+{
+    auto& pool = backward ? backward_pool_ : forward_pool_;
+    const auto batches = (n + WORLDS_PER_MASK - 1) / WORLDS_PER_MASK;
+    const auto live_batches = growPool(pool, batches, backward);
+    if(!live_batches) {
+        return backward
+            ? fresh_worlds_.cascadeBackwardN(seeds, n)
+            : fresh_worlds_.cascadeForwardN(seeds, n);
+    }
+
+    return std::transform_reduce(
+        std::execution::par,
+        std::begin(range(batches)),
+        std::end(range(batches)),
+        0.0,
+        [](auto acc, auto current) {
+            return acc + current;
+        },
+        [&](auto batch) {
+            const auto worlds = bitparallel::firstWorlds(n - batch * WORLDS_PER_MASK);
+            const auto* live_worlds = live_batches.value()[batch];
+
+            return bitparallel::propagateWorlds(
+                       graph_,
+                       seeds,
+                       worlds,
+                       backward,
+                       [&](const auto& /* edge */, auto edge_index, auto candidates) {
+                           return candidates & live_worlds[edge_index];
+                       },
+                       nullptr)
+                / static_cast<double>(n);
+        });
+}
+
+auto SnapshotCascader::cascadeForwardN(const std::vector<NodeId>& seeds,
+                                       std::size_t n) const noexcept
+    -> double
+{
+    return cascadeN(seeds, n, false);
+}
+
+auto SnapshotCascader::cascadeBackwardN(const std::vector<NodeId>& seeds,
+                                        std::size_t n) const noexcept
+    -> double
+{
+    return cascadeN(seeds, n, true);
+}
+
+auto SnapshotCascader::sampleForwardN(const std::vector<NodeId>& seeds,
+                                      std::size_t n) const noexcept
+    -> util::RunningStatistics
+{
+    return fresh_worlds_.sampleForwardN(seeds, n);
+}
+
+auto SnapshotCascader::sampleBackwardN(const std::vector<NodeId>& seeds,
+                                       std::size_t n) const noexcept
+    -> util::RunningStatistics
+{
+    return fresh_worlds_.sampleBackwardN(seeds, n);
+}
+
+auto SnapshotCascader::cascadeForwardCurveN(const std::vector<NodeId>& seeds,
+                                            std::size_t n) const noexcept
+    -> std::vector<double>
+{
+    const auto batches = (n + WORLDS_PER_MASK - 1) / WORLDS_PER_MASK;
+    const auto live_batches = growPool(forward_pool_, batches, false);
+    if(!live_batches) {
+        return fresh_worlds_.cascadeForwardCurveN(seeds, n);
+    }
+
+    return std::transform_reduce(
+        std::execution::par,
+        std::begin(range(batches)),
+        std::end(range(batches)),
+        std::vector<double>(seeds.size(), 0.0),
+        [](auto acc, const auto& current) {
+            std::transform(std::begin(acc), std::end(acc), std::begin(current), std::begin(acc), std::plus<>{});
+            return acc;
+        },
+        [&](auto batch) {
+            const auto worlds = bitparallel::firstWorlds(n - batch * WORLDS_PER_MASK);
+            const auto* live_worlds = live_batches.value()[batch];
+
+            const auto activated = bitparallel::propagateWorldsCurve(
+                graph_,
+                seeds,
+                worlds,
+                false,
+                [&](const auto& /* edge */, auto edge_index, auto candidates) {
+                    return candidates & live_worlds[edge_index];
+                });
+
+            std::vector<double> curve(seeds.size());
+            std::transform(std::begin(activated), std::end(activated), std::begin(curve), [&](auto count) {
+                return count / static_cast<double>(n);
+            });
+            return curve;
+        });
+}
@@ -1,9 +1,11 @@
-#include <dSFMT.h>
+#include <diffusion/WorldPropagation.hpp>
 #include <execution>
 #include <queue>
 #include <random>
 #include <solver/CelfGreedy.hpp>
+#include <unordered_map>
 #include <unordered_set>
+#include <util/SimulationScratch.hpp>
 
 CelfGreedy::CelfGreedy(const Graph& graph, const int simulations) noexcept
     : graph_(graph),
@@ -20,12 +22,7 @@ auto CelfGreedy::solve(std::size_t k) noexcept
     std::vector<NodeId> seed_set;
     double seed_set_spread = 0;
 
-    std::for_each(std::execution::seq,
-                  nodes.begin(),
-                  nodes.end(),
-                  [&](auto node) {
-                      spread_delta_[node] = evaluateSpread(node, seed_set);
-                  });
+    initializeSpreads();
     std::unordered_map<NodeId, double> updated_with_total_spread;
     auto seed_comparison =
         [&](const auto& lhs, const auto& rhs) {
@@ -45,6 +42,7 @@ auto CelfGreedy::solve(std::size_t k) noexcept
     priority_queue.pop();
     seed_set.reserve(k);
     seed_set.emplace_back(initial_top_node);
+    seed_set_spread = spread_delta_[initial_top_node];
 
     while(seed_set.size() < k) {
         auto top_node = priority_queue.top();
@@ -80,9 +78,72 @@ auto CelfGreedy::name() const noexcept
 {
     return "CELF-Greedy," + std::to_string(simulations_);
 }
+auto CelfGreedy::initializeSpreads() noexcept
+    -> void
+{
+    using bitparallel::WORLDS_PER_MASK;
+
+    const auto family = util::RandomService::newStreamFamily();
+    const auto number_of_nodes = static_cast<std::size_t>(graph_.getNumberOfNodes());
+    const auto nodes = graph_.getNodes();
+    const auto simulations = static_cast<std::size_t>(simulations_);
+    const auto batches = (simulations + WORLDS_PER_MASK - 1) / WORLDS_PER_MASK;
+
+    // sum of the activated nodes over all worlds
+    std::vector<std::uint64_t> activated(number_of_nodes, 0);
+    std::vector<bitparallel::WorldMask> live_worlds(graph_.getNumberOfEdges());
+
+    for(std::size_t batch = 0; batch < batches; ++batch) {
+        const auto worlds = bitparallel::firstWorlds(simulations - batch * WORLDS_PER_MASK);
+
+        // the edges of every node are drawn from its own stream, hence the worlds do not depend on the scheduling
+        graph_.visitEdges(false, [&](auto edges_of) {
+            std::for_each(std::execution::par,
+                          std::begin(nodes),
+                          std::end(nodes),
+                          [&](auto node) {
+                              auto generator = util::RandomService::stream(family, batch * number_of_nodes + node);
+                              const auto edges = edges_of(node);
+                              const auto first_edge = graph_.getEdgeOffsetOf(node);
+                              for(std::size_t i = 0; i < edges.size(); ++i) {
+                                  live_worlds[first_edge + i] =
+                                      bitparallel::drawLiveWorlds(edges[i].getWeight(), worlds, generator);
+                              }
+                          });
+        });
+
+        // every node spreads in the same worlds, the per thread scratch is reused for all of them
+        std::for_each(std::execution::par,
+                      std::begin(nodes),
+                      std::end(nodes),
+                      [&](auto node) {
+                          thread_local std::vector<NodeId> seed(1);
+                          seed[0] = node;
+                          activated[node] += bitparallel::propagateWorlds(
+                              graph_,
+                              seed,
+                              worlds,
+                              false,
+                              [&](const auto& /* edge */, auto edge_index, auto candidates) {
+                                  return live_worlds[edge_index] & candidates;
+                              },
+                              nullptr);
+                      });
+    }
+
+    std::for_each(std::execution::par,
+                  std::begin(nodes),
+                  std::end(nodes),
+                  [&](auto node) {
+                      spread_delta_[node] = static_cast<double>(activated[node]) / static_cast<double>(simulations);
+                  });
+}
+
 auto CelfGreedy::evaluateSpread(NodeId node, std::vector<NodeId>& seed_set) const noexcept
     -> double
 {
+    const auto family = util::RandomService::newStreamFamily();
+
     return std::transform_reduce(
         std::execution::par,
         std::begin(utils::range(simulations_)),
@@ -91,25 +152,28 @@ auto CelfGreedy::evaluateSpread(NodeId node, std::vector<NodeId>& seed_set) cons
         [](auto acc, auto current) {
             return acc + current;
         },
-        [&](auto /*node*/) {
-            return static_cast<double>(singleSimulation(node, seed_set))
+        [&](auto simulation) {
+            auto generator = util::RandomService::stream(family, simulation);
+            return static_cast<double>(singleSimulation(node, seed_set, generator))
                 / static_cast<double>(simulations_);
         });
 }
-auto CelfGreedy::singleSimulation(NodeId node, std::vector<NodeId>& seed_set) const noexcept
+auto CelfGreedy::singleSimulation(NodeId node,
+                                  std::vector<NodeId>& seed_set,
+                                  util::RandomGenerator& generator) const noexcept
     -> long
 {
-    std::vector activated(graph_.getNumberOfNodes(), false);
+    auto& scratch = util::SimulationScratch::local(graph_.getNumberOfNodes());
+    auto& work_queue = scratch.workQueue();
+
     for(const auto seed_node : seed_set) {
-        activated[seed_node] = true;
+        if(scratch.activate(seed_node)) {
+            work_queue.emplace_back(seed_node);
+        }
+    }
+    if(scratch.activate(node)) {
+        work_queue.emplace_back(node);
     }
-    activated[node] = true;
-
-    dsfmt_t dsfmt;
-    dsfmt_init_gen_rand(&dsfmt, rand());
-
-    std::vector<NodeId> work_queue = seed_set;
-    work_queue.emplace_back(node);
 
     while(!work_queue.empty()) {
 
@@ -117,18 +181,16 @@ auto CelfGreedy::singleSimulation(NodeId node, std::vector<NodeId>& seed_set) co
         work_queue.pop_back();
 
         for(auto neighbor_edge : graph_.getEdgesOf(current_node)) {
-            if(activated[neighbor_edge.getDestination()]) {
+            if(scratch.isActivated(neighbor_edge.getDestination())) {
                 continue;
             }
-            auto rnd = dsfmt_genrand_close_open(&dsfmt);
+            auto rnd = generator.nextDouble();
             if(rnd < neighbor_edge.getWeight()) {
-                activated[neighbor_edge.getDestination()] = true;
+                scratch.activate(neighbor_edge.getDestination());
                 work_queue.emplace_back(neighbor_edge.getDestination());
             }
         }
     }
 
-    return std::count_if(activated.begin(),
-                         activated.end(),
-                         [](auto x) { return x; });
+    return static_cast<long>(scratch.activatedNodes().size());
 }
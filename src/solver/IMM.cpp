@@ -1,16 +1,45 @@
 #include <Benchmarker.hpp>
 #include <execution>
-#include <mutex>
 #include <solver/IMM.hpp>
+#include <solver/RrSetFile.hpp>
+#include <util/SimulationScratch.hpp>
+
+IMM::IMM(const Graph& graph,
+         util::DiffusionModel diffusion_model,
+         std::optional<std::string> rr_set_path) noexcept
+    : graph_(graph),
+      // the bit parallel and snapshot models simulate the independent cascade model as well
+      diffusion_model_(diffusion_model == util::DiffusionModel::LINEAR_THRESHOLD
+                           ? util::DiffusionModel::LINEAR_THRESHOLD
+                           : util::DiffusionModel::INDEPENDENT_CASCADE),
+      rr_sets_(graph.getNumberOfNodes()),
+      coverage_(rr_sets_, graph.getNumberOfNodes()),
+      rr_set_path_(std::move(rr_set_path))
+{
+    if(diffusion_model_ == util::DiffusionModel::LINEAR_THRESHOLD) {
+        live_in_edges_.emplace(graph);
+    } else {
+        inverse_edges_.emplace(graph, true);
+    }
+}
 
-IMM::IMM(const Graph& graph) noexcept
-    : graph_(graph) {}
+auto IMM::storeRrSets()
+    -> bool
+{
+    if(!rr_set_path_ or rr_sets_.size() <= stored_rr_sets_) {
+        return true;
+    }
+
+    if(!writeRrSetFile(rr_set_path_.value(), rr_sets_, graph_, diffusion_model_)) {
+        return false;
+    }
+    stored_rr_sets_ = rr_sets_.size();
+    return true;
+}
 
 auto IMM::solve(const std::size_t k) noexcept
     -> std::vector<NodeId>
 {
-    const int rr_batch_size = 1; // TODO change back to a higher number for runtime optimization after sufficient testing of the current implementation
-
     const double epsilon = 0.5; // epsilon and l are taken from the paper
     const double e = std::exp(1.);
 
@@ -30,13 +59,22 @@ auto IMM::solve(const std::size_t k) noexcept
         * n / (epsilon_a * epsilon_a); // eq 9
 
 
-    dsfmt_t dsfmt;
-    dsfmt_init_gen_rand(&dsfmt, rand());
+    // the rr set with index i uses the random stream i of this family
+    const auto family = util::RandomService::newStreamFamily();
+    const auto sample_rr_set = [&](auto index, auto& nodes) {
+        auto generator = util::RandomService::stream(family, index);
+        createRrSet(generator, nodes);
+    };
+
+    // rr sets of earlier runs are reused, the phases below only sample the missing ones
+    if(rr_set_path_ and rr_sets_.size() == 0) {
+        readRrSetFile(rr_set_path_.value(), rr_sets_, graph_, diffusion_model_);
+        stored_rr_sets_ = rr_sets_.size();
+    }
 
     auto lower_bound = 1;
     double x;
     double theta_i;
-    std::mutex mtx;
 
     // cache stuff
     std::vector<NodeId> result_set;
@@ -47,26 +85,7 @@ auto IMM::solve(const std::size_t k) noexcept
     for(int i = 1; i < log_2n - 1; ++i) {
         x = n / (std::pow(2., i));
         theta_i = lambda_a / x;
-        rr_sets_.reserve(theta_i + rr_batch_size);
-        auto size = rr_sets_.size();
-        auto range = utils::range(size, size + 1 + (static_cast<std::int64_t>(theta_i) - size) / rr_batch_size);
-
-        //could be flatted to only one loop i guess
-        std::for_each(
-            std::execution::par,
-            std::begin(range),
-            std::end(range),
-            [&](auto /*y*/) {
-                std::vector<std::vector<NodeId>> temp;
-                temp.reserve(rr_batch_size);
-                for(int j = 0; j < rr_batch_size; ++j) {
-                    temp.emplace_back(createRrSet(dsfmt));
-                }
-                std::lock_guard lock{mtx};
-                rr_sets_.insert(std::end(rr_sets_),
-                                std::begin(temp),
-                                std::end(temp));
-            });
+        rr_sets_.extend(static_cast<std::size_t>(theta_i) + 1, sample_rr_set);
 
         // check early termination
         std::tie(result_set, f_r) = nodeSelection(k);
@@ -79,28 +98,9 @@ auto IMM::solve(const std::size_t k) noexcept
 
     // create more rr sets, if necessary
     const auto theta = lambda_star / lower_bound;
-    const auto size = rr_sets_.size();
     if(rr_sets_.size() < theta) {
-        rr_sets_.reserve(theta + rr_batch_size);
         rr_sets_changed = true;
-        auto range = utils::range(size, size + 1 + (static_cast<std::int64_t>(theta) - size) / rr_batch_size);
-
-        std::for_each(
-            std::execution::par,
-            std::begin(range),
-            std::end(range),
-            [&](auto /*x*/) {
-                std::vector<std::vector<NodeId>> temp;
-                temp.reserve(rr_batch_size);
-                for(int i = 0; i < rr_batch_size; ++i) {
-                    temp.emplace_back(createRrSet(dsfmt));
-                }
-
-                std::lock_guard lock{mtx};
-                rr_sets_.insert(rr_sets_.end(),
-                                std::begin(temp),
-                                std::end(temp));
-            });
+        rr_sets_.extend(static_cast<std::size_t>(theta) + 1, sample_rr_set);
     }
     //fmt::print("Step 2 RR-sets: {}\n", rr_sets_.size());
 
@@ -118,38 +118,67 @@ auto IMM::name() const noexcept
     return "IMM";
 }
 
-auto IMM::createRrSet(dsfmt_t dsfmt) const noexcept
-    -> std::vector<NodeId>
+auto IMM::createRrSet(util::RandomGenerator& generator,
+                      std::vector<RrSetStore::NodeIndex>& rr_set) const noexcept
+    -> void
 {
-    //should be member
-    std::vector visited(graph_.getNumberOfNodes(), false);
+    // most rr sets only contain a few nodes, those are checked by scanning the set itself.
+    // Larger sets switch to the epoch stamped marks of this thread, hence an rr set never costs O(|V|)
+    constexpr std::size_t SCAN_LIMIT = 32;
+
+    auto& scratch = util::SimulationScratch::local(graph_.getNumberOfNodes());
+    const auto first = rr_set.size();
+    auto use_marks = false;
+
+    const auto visited = [&](NodeId node) {
+        if(use_marks) {
+            return scratch.isActivated(node);
+        }
+        return std::find(std::begin(rr_set) + first, std::end(rr_set), node) != std::end(rr_set);
+    };
+
+    const auto add = [&](NodeId node) {
+        rr_set.emplace_back(static_cast<RrSetStore::NodeIndex>(node));
+        if(use_marks) {
+            scratch.activate(node);
+        } else if(rr_set.size() - first > SCAN_LIMIT) {
+            for(auto added : std::span(rr_set).subspan(first)) {
+                scratch.activate(added);
+            }
+            use_marks = true;
+        }
+    };
+
+    const auto source_node = graph_.getRandomNode(generator);
 
-    const auto source_node = graph_.getRandomNode();
-    std::vector<NodeId> rr_set;
+    // linear threshold: every node has at most one live in-edge, hence the rr set is a reverse random walk,
+    // which ends at a node without live in-edge or at a node which is already part of the rr set
+    if(live_in_edges_) {
+        for(std::optional<NodeId> current = source_node;
+            current and !visited(current.value());
+            current = live_in_edges_->sample(current.value(), generator)) {
+            add(current.value());
+        }
+        return;
+    }
 
-    //this is named queue but is actually used as a stack
-    //is this right?
-    std::vector<NodeId> queue;
+    // used as a stack, the order in which the nodes are visited does not change the rr set
+    auto& queue = scratch.workQueue();
     queue.emplace_back(source_node);
 
     while(!queue.empty()) {
         const auto current_node = queue.back();
         queue.pop_back();
-        if(visited[current_node]) {
+        if(visited(current_node)) {
             continue;
         }
 
-        visited[current_node] = true;
-        rr_set.emplace_back(current_node);
-        for(auto edge : graph_.getInverseEdgesOf(current_node)) {
+        add(current_node);
 
-            auto rnd = dsfmt_genrand_close_open(&dsfmt);
-            if(edge.getWeight() > rnd) {
-                queue.emplace_back(edge.getDestination());
-            }
-        }
+        inverse_edges_->forEachLiveEdge(current_node, generator, [&](auto destination) {
+            queue.emplace_back(destination);
+        });
     }
-    return rr_set;
 }
 
 
@@ -167,63 +196,9 @@ auto IMM::logBinom(const std::size_t n, const std::size_t k) const noexcept
     return ans;
 }
 
-auto IMM::nodeSelection(std::size_t k) const noexcept
+auto IMM::nodeSelection(std::size_t k) noexcept
     -> std::pair<std::vector<NodeId>, double>
 {
-    //this should be a member of IMM with a reset function to only pay for what is used
-    std::vector rr_set_already_covered(rr_sets_.size(), false);
-    // coverage counter for the nodes
-    std::vector<std::vector<std::size_t>> counter(graph_.getNumberOfNodes());
-    std::vector<NodeId> result_set;
-
-    // fill the coverage counter
-    for(std::size_t i = 0; i < rr_sets_.size(); ++i) {
-        for(auto current_node : rr_sets_[i]) {
-            counter[current_node].emplace_back(i);
-        }
-    }
-
-    // pick the best nodes
-    while(result_set.size() < k) {
-
-        // find max node
-        NodeId max_id = 0;
-        std::size_t max_size = 0;
-
-        for(auto i = 0; i < graph_.getNumberOfNodes(); ++i) {
-            if(counter[i].size() > max_size) {
-                max_id = i;
-                max_size = counter[i].size();
-            }
-        }
-
-        // mark rr sets as covered
-        for(auto rr_set_id : counter[max_id]) {
-            rr_set_already_covered[rr_set_id] = true;
-
-            // remove counter entries for covered rr sets
-            for(auto member : rr_sets_[rr_set_id]) {
-                //auto x = 0;
-                if(member == max_id) {
-                    continue;
-                }
-                counter[member].erase(
-                    std::remove_if(counter[member].begin(),
-                                   counter[member].end(),
-                                   [rr_set_id](auto elem) {
-                                       return elem == rr_set_id;
-                                   }),
-                    counter[member].end());
-            }
-        }
-        counter[max_id].clear();
-        result_set.emplace_back(max_id);
-    }
-
-    //why is the result of a count a double here?
-    long influence = std::count_if(std::begin(rr_set_already_covered),
-                                   std::end(rr_set_already_covered),
-                                   [](auto x) { return x; });
-    double f_r = static_cast<double>(influence) / static_cast<double>(rr_sets_.size());
-    return {result_set, f_r};
+    coverage_.extend();
+    return coverage_.select(k);
 }
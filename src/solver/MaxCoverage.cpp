@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <numeric>
+#include <queue>
+#include <solver/MaxCoverage.hpp>
+#include <util/PackedArray.hpp>
+
+MaxCoverage::MaxCoverage(const RrSetStore& rr_sets, std::size_t number_of_nodes)
+    : rr_sets_(rr_sets),
+      number_of_nodes_(number_of_nodes),
+      node_offsets_(number_of_nodes + 1, 0)
+{
+    extend();
+}
+
+auto MaxCoverage::extend()
+    -> void
+{
+    const auto first = indexed_;
+    const auto count = rr_sets_.size();
+    if(count <= first) {
+        return;
+    }
+
+    if(!util::PackedArray::fitsNarrow(count)) {
+        fmt::print("the inverted index stores rr set ids with 32 bits, there are {} rr sets\n", count);
+        std::exit(1);
+    }
+
+    // the lists grow by the number of new rr sets containing the node
+    std::vector<std::size_t> offsets(number_of_nodes_ + 1, 0);
+    for(auto i = first; i < count; ++i) {
+        for(auto node : rr_sets_[i]) {
+            ++offsets[node + 1];
+        }
+    }
+    for(std::size_t node = 0; node < number_of_nodes_; ++node) {
+        offsets[node + 1] += node_offsets_[node + 1] - node_offsets_[node];
+    }
+    std::inclusive_scan(std::begin(offsets), std::end(offsets), std::begin(offsets));
+
+    // every list only moves to the back, hence the old lists are moved in place starting with the last node
+    rr_set_ids_.resize(offsets.back());
+    std::vector<std::size_t> positions(number_of_nodes_);
+    for(auto node = number_of_nodes_; node-- > 0;) {
+        const auto old_begin = std::begin(rr_set_ids_) + node_offsets_[node];
+        const auto old_end = std::begin(rr_set_ids_) + node_offsets_[node + 1];
+        positions[node] = offsets[node] + (node_offsets_[node + 1] - node_offsets_[node]);
+        std::copy_backward(old_begin, old_end, std::begin(rr_set_ids_) + positions[node]);
+    }
+
+    // the new rr sets are appended to the lists, which stay sorted by rr set id
+    for(auto i = first; i < count; ++i) {
+        for(auto node : rr_sets_[i]) {
+            rr_set_ids_[positions[node]++] = static_cast<RrSetIndex>(i);
+        }
+    }
+
+    node_offsets_ = std::move(offsets);
+    indexed_ = count;
+}
+
+auto MaxCoverage::select(std::size_t k) const
+    -> std::pair<std::vector<NodeId>, double>
+{
+    // number of uncovered rr sets containing the node
+    std::vector<std::uint32_t> coverage(number_of_nodes_);
+    std::vector<std::pair<std::uint32_t, NodeId>> entries(number_of_nodes_);
+    for(std::size_t node = 0; node < number_of_nodes_; ++node) {
+        coverage[node] = static_cast<std::uint32_t>(node_offsets_[node + 1] - node_offsets_[node]);
+        entries[node] = {coverage[node], static_cast<NodeId>(node)};
+    }
+
+    // larger coverage first, smaller node id on ties
+    const auto lower_priority = [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first
+            or (lhs.first == rhs.first and lhs.second > rhs.second);
+    };
+    std::priority_queue heap(lower_priority, std::move(entries));
+
+    std::vector<char> covered(rr_sets_.size(), false);
+    std::vector<RrSetIndex> newly_covered;
+    std::size_t number_of_covered = 0;
+
+    std::vector<NodeId> result_set;
+    result_set.reserve(k);
+
+    while(result_set.size() < k and !heap.empty()) {
+        const auto [entry_coverage, node] = heap.top();
+        heap.pop();
+
+        if(entry_coverage != coverage[node]) {
+            heap.emplace(coverage[node], node);
+            continue;
+        }
+        result_set.emplace_back(node);
+
+        newly_covered.clear();
+        for(auto offset = node_offsets_[node]; offset < node_offsets_[node + 1]; ++offset) {
+            const auto rr_set_id = rr_set_ids_[offset];
+            if(!covered[rr_set_id]) {
+                covered[rr_set_id] = true;
+                newly_covered.emplace_back(rr_set_id);
+            }
+        }
+        number_of_covered += newly_covered.size();
+
+        // the members of the newly covered rr sets lose one uncovered rr set each
+        std::for_each(
+            std::execution::par,
+            std::begin(newly_covered),
+            std::end(newly_covered),
+            [&](auto rr_set_id) {
+                for(auto member : rr_sets_[rr_set_id]) {
+                    std::atomic_ref(coverage[member]).fetch_sub(1, std::memory_order_relaxed);
+                }
+            });
+    }
+
+    const auto f_r = static_cast<double>(number_of_covered) / static_cast<double>(rr_sets_.size());
+    return {result_set, f_r};
+}
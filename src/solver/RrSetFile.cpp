@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fmt/core.h>
+#include <fstream>
+#include <solver/RrSetFile.hpp>
+#include <util/MemoryMap.hpp>
+
+namespace {
+
+constexpr std::array<char, 8> RR_SET_MAGIC = {'I', 'M', 'B', 'R', 'R', 'S', 'E', 'T'};
+constexpr std::uint32_t RR_SET_VERSION = 2;
+
+struct RrSetFileHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t diffusion_model;
+    std::uint64_t number_of_nodes;
+    std::uint64_t number_of_edges;
+    std::uint64_t graph_fingerprint;
+    std::uint64_t number_of_rr_sets;
+    std::uint64_t number_of_entries;
+    // size of the encoded rr sets following the header
+    std::uint64_t data_size;
+};
+
+auto writeVarint(std::vector<char>& buffer, std::uint64_t value)
+    -> void
+{
+    while(value >= 0x80) {
+        buffer.emplace_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.emplace_back(static_cast<char>(value));
+}
+
+/**
+ * @return false if the varint does not end before end
+ */
+auto readVarint(const char*& position, const char* end, std::uint64_t& value) noexcept
+    -> bool
+{
+    value = 0;
+    for(int shift = 0; position != end and shift < 64; shift += 7) {
+        const auto byte = static_cast<std::uint8_t>(*position++);
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+auto writeRrSetFile(std::string_view path,
+                    const RrSetStore& rr_sets,
+                    const Graph& graph,
+                    util::DiffusionModel diffusion_model)
+    -> bool
+{
+    // every rr set: its size followed by the first id and the gaps to the previous id
+    std::vector<char> data;
+    data.reserve(rr_sets.numberOfEntries() * 2);
+    std::vector<RrSetStore::NodeIndex> sorted;
+    for(std::size_t i = 0; i < rr_sets.size(); ++i) {
+        const auto rr_set = rr_sets[i];
+        sorted.assign(std::begin(rr_set), std::end(rr_set));
+        std::sort(std::begin(sorted), std::end(sorted));
+
+        writeVarint(data, sorted.size());
+        RrSetStore::NodeIndex previous = 0;
+        for(auto node : sorted) {
+            writeVarint(data, node - previous);
+            previous = node;
+        }
+    }
+
+    RrSetFileHeader header{};
+    header.magic = RR_SET_MAGIC;
+    header.version = RR_SET_VERSION;
+    header.diffusion_model = static_cast<std::uint32_t>(diffusion_model);
+    header.number_of_nodes = graph.getNumberOfNodes();
+    header.number_of_edges = graph.getNumberOfEdges();
+    header.graph_fingerprint = graph.getFingerprint(true);
+    header.number_of_rr_sets = rr_sets.size();
+    header.number_of_entries = rr_sets.numberOfEntries();
+    header.data_size = data.size();
+
+    // the old file stays valid until the new one is complete
+    const auto temporary_path = fmt::format("{}.tmp", path);
+    {
+        std::ofstream out_file{temporary_path, std::ios::out | std::ios::binary};
+        if(!out_file) {
+            fmt::print("could not open {} for writing\n", temporary_path);
+            return false;
+        }
+
+        out_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out_file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if(!out_file) {
+            fmt::print("could not write rr set file {}\n", temporary_path);
+            return false;
+        }
+    }
+
+    return std::rename(temporary_path.c_str(), std::string{path}.c_str()) == 0;
+}
+
+auto readRrSetFile(std::string_view path,
+                   RrSetStore& rr_sets,
+                   const Graph& graph,
+                   util::DiffusionModel diffusion_model)
+    -> bool
+{
+    const util::MemoryMap mapping{std::string{path}};
+    if(!mapping.isValid()) {
+        return false;
+    }
+    mapping.adviseSequential();
+
+    RrSetFileHeader header{};
+    if(mapping.size() < sizeof(header)) {
+        fmt::print("File {} is not an rr set file\n", path);
+        return false;
+    }
+    std::memcpy(&header, mapping.data(), sizeof(header));
+
+    if(header.magic != RR_SET_MAGIC or header.version != RR_SET_VERSION) {
+        fmt::print("File {} is not an rr set file of version {}\n", path, RR_SET_VERSION);
+        return false;
+    }
+
+    const auto number_of_nodes = static_cast<std::uint64_t>(graph.getNumberOfNodes());
+    const auto number_of_edges = static_cast<std::uint64_t>(graph.getNumberOfEdges());
+    if(header.diffusion_model != static_cast<std::uint32_t>(diffusion_model)
+       or header.number_of_nodes != number_of_nodes
+       or header.number_of_edges != number_of_edges
+       or header.graph_fingerprint != graph.getFingerprint(true)) {
+        fmt::print("rr set file {} was sampled on another graph or diffusion model\n", path);
+        return false;
+    }
+
+    if(header.data_size > mapping.size() - sizeof(header)) {
+        fmt::print("rr set file {} is truncated\n", path);
+        return false;
+    }
+
+    // every rr set and every entry takes at least one varint byte, larger counts can not be decoded from the data
+    if(header.number_of_rr_sets > header.data_size or header.number_of_entries > header.data_size) {
+        fmt::print("rr set file {} is corrupted\n", path);
+        return false;
+    }
+
+    const auto* position = mapping.data() + sizeof(header);
+    const auto* end = position + header.data_size;
+
+    // the rr sets are decoded into the store, a corrupted file removes the ones appended so far
+    const auto old_size = rr_sets.size();
+    rr_sets.reserve(old_size + header.number_of_rr_sets, rr_sets.numberOfEntries() + header.number_of_entries);
+
+    const auto corrupted = [&] {
+        fmt::print("rr set file {} is corrupted\n", path);
+        rr_sets.truncate(old_size);
+        return false;
+    };
+
+    std::vector<RrSetStore::NodeIndex> rr_set;
+    for(std::uint64_t i = 0; i < header.number_of_rr_sets; ++i) {
+        std::uint64_t size;
+        if(!readVarint(position, end, size) or size > number_of_nodes) {
+            return corrupted();
+        }
+
+        rr_set.resize(size);
+        std::uint64_t node = 0;
+        for(auto& entry : rr_set) {
+            std::uint64_t gap;
+            if(!readVarint(position, end, gap) or (node += gap) >= number_of_nodes) {
+                return corrupted();
+            }
+            entry = static_cast<RrSetStore::NodeIndex>(node);
+        }
+        rr_sets.append(rr_set);
+    }
+
+    return true;
+}
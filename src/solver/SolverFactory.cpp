@@ -14,7 +14,11 @@
 #include <solver/simple/WeightedPageRank.hpp>
 
 
-auto SolverFactory::benchmarkAll(const std::vector<std::string>& arguments, Graph& graph, Benchmarker& bm) noexcept
+auto SolverFactory::benchmarkAll(const std::vector<std::string>& arguments,
+                                 Graph& graph,
+                                 Benchmarker& bm,
+                                 util::DiffusionModel diffusion_model,
+                                 const std::optional<std::string>& rr_set_path) noexcept
     -> void
 {
     int argument_count = 0;
@@ -111,7 +115,7 @@ auto SolverFactory::benchmarkAll(const std::vector<std::string>& arguments, Grap
                 }
 
                 if(solver_arg == "imm") {
-                    return std::make_unique<IMM>(graph);
+                    return std::make_unique<IMM>(graph, diffusion_model, rr_set_path);
                 }
 
                 // "Default" case
@@ -68,33 +68,35 @@ auto EaSyIM::performWeightedDegreeIteration(const int iteration) noexcept
     const auto& lookup = iteration % 2 == 0 ? weighted_degree_odd_ : weighted_degree_even_;
 
 
-    std::for_each(std::execution::par,
-                  graph_.getNodes().begin(),
-                  graph_.getNodes().end(),
-                  [&](auto current_node) {
-                      if(selected_nodes_.count(current_node) != 0) {
-                          return;
-                      }
-
-                      // accumulate neighbor scores from the previous round
-                      updated[current_node] = std::transform_reduce(
-                          std::execution::unseq,
-                          std::begin(graph_.getEdgesOf(current_node)),
-                          std::end(graph_.getEdgesOf(current_node)),
-                          lookup[current_node],
-                          std::plus<>(),
-                          [&](auto edge) {
-                              // reduce neighbor score by the edge weight
-                              auto destination = edge.getDestination();
-
-                              //ignore selected nodes
-                              if(selected_nodes_.count(destination) != 0) {
-                                  return 0.0f;
-                              }
-
-                              return edge.getWeight() * lookup[destination];
-                          });
-                  });
+    graph_.visitEdges(false, [&](auto edges_of) {
+        std::for_each(std::execution::par,
+                      graph_.getNodes().begin(),
+                      graph_.getNodes().end(),
+                      [&](auto current_node) {
+                          if(selected_nodes_.count(current_node) != 0) {
+                              return;
+                          }
+
+                          // accumulate neighbor scores from the previous round
+                          updated[current_node] = std::transform_reduce(
+                              std::execution::unseq,
+                              std::begin(edges_of(current_node)),
+                              std::end(edges_of(current_node)),
+                              lookup[current_node],
+                              std::plus<>(),
+                              [&](auto edge) {
+                                  // reduce neighbor score by the edge weight
+                                  auto destination = edge.getDestination();
+
+                                  //ignore selected nodes
+                                  if(selected_nodes_.count(destination) != 0) {
+                                      return 0.0f;
+                                  }
+
+                                  return edge.getWeight() * lookup[destination];
+                              });
+                      });
+    });
 }
 
 auto EaSyIM::name() const noexcept
@@ -69,23 +69,25 @@ auto EasyImDelta::performWeightedDegreeIteration(const std::vector<NodeId>& node
     const auto& lookup = iteration % 2 == 0 ? weighted_degree_1_ : weighted_degree_0_;
 
 
-    std::for_each(std::execution::par,
-                  nodes.begin(),
-                  nodes.end(),
-                  [&](auto current_node) {
-                      // accumulate neighbor scores from the previous round
-                      updated[current_node] = std::transform_reduce(
-                          std::execution::unseq,
-                          std::begin(graph_.getEdgesOf(current_node)),
-                          std::end(graph_.getEdgesOf(current_node)),
-                          lookup[current_node],
-                          std::plus<>(),
-                          [&](auto edge) {
-                              // reduce neighbor score by the edge weight
-                              auto destination = edge.getDestination();
-                              return edge.getWeight() * lookup[destination];
-                          });
-                  });
+    graph_.visitEdges(false, [&](auto edges_of) {
+        std::for_each(std::execution::par,
+                      nodes.begin(),
+                      nodes.end(),
+                      [&](auto current_node) {
+                          // accumulate neighbor scores from the previous round
+                          updated[current_node] = std::transform_reduce(
+                              std::execution::unseq,
+                              std::begin(edges_of(current_node)),
+                              std::end(edges_of(current_node)),
+                              lookup[current_node],
+                              std::plus<>(),
+                              [&](auto edge) {
+                                  // reduce neighbor score by the edge weight
+                                  auto destination = edge.getDestination();
+                                  return edge.getWeight() * lookup[destination];
+                              });
+                      });
+    });
 }
 auto EasyImDelta::name() const noexcept
     -> std::string
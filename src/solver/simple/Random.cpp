@@ -1,5 +1,4 @@
 #include "solver/simple/Random.hpp"
-#include <random>
 #include <algorithm>
 
 Random::Random(const Graph& graph) noexcept
@@ -8,15 +7,12 @@ Random::Random(const Graph& graph) noexcept
 auto Random::solve(std::size_t k) noexcept
     -> std::vector<NodeId>
 {
-    // TODO: use parallel RandomGenerator
-    std::random_device rd;
-    std::mt19937 mt(rd());
-    std::uniform_int_distribution<NodeId> dist(0, graph_.getNumberOfNodes() - 1);
+    auto generator = util::RandomService::stream(util::RandomService::newStreamFamily(), 0);
 
     std::vector<NodeId> seeds;
 
     while(seeds.size() < k) {
-        auto rnd_node = dist(mt);
+        auto rnd_node = graph_.getRandomNode(generator);
 
         if(std::find(seeds.begin(), seeds.end(), rnd_node) == seeds.end()) {
             seeds.emplace_back(rnd_node);
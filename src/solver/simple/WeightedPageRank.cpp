@@ -69,29 +69,31 @@ auto WeightedPageRank::runSingleWeightedPageRankIteration() noexcept
     auto dumping_factor = 0.85;
     auto nodes = graph_.getNodes();
 
-    std::for_each(std::execution::par,
-                  std::begin(nodes),
-                  std::end(nodes),
-                  [&](auto current_node) {
-                      auto out_neighbors = graph_.getEdgesOf(current_node);
-                      auto sum = std::transform_reduce(
-                          std::execution::unseq,
-                          std::begin(out_neighbors),
-                          std::end(out_neighbors),
-                          0.0,
-                          [&](auto init, auto new_value) {
-                              return init + new_value;
-                          },
-                          [&](Edge in_edge) {
-                              auto target = in_edge.getDestination();
-                              // probability sum will be 1 in the WC model, however this way the code also works for other models later
-                              auto edge_probability = in_edge.getWeight() / probability_sum_[target];
-                              return static_cast<double>(page_rank_[target])
-                                  * static_cast<double>(edge_probability);
-                          });
-
-                      temp_page_rank_[current_node] = (1 - dumping_factor) + dumping_factor * sum;
-                  });
+    graph_.visitEdges(false, [&](auto edges_of) {
+        std::for_each(std::execution::par,
+                      std::begin(nodes),
+                      std::end(nodes),
+                      [&](auto current_node) {
+                          auto out_neighbors = edges_of(current_node);
+                          auto sum = std::transform_reduce(
+                              std::execution::unseq,
+                              std::begin(out_neighbors),
+                              std::end(out_neighbors),
+                              0.0,
+                              [&](auto init, auto new_value) {
+                                  return init + new_value;
+                              },
+                              [&](Edge in_edge) {
+                                  auto target = in_edge.getDestination();
+                                  // probability sum will be 1 in the WC model, however this way the code also works for other models later
+                                  auto edge_probability = in_edge.getWeight() / probability_sum_[target];
+                                  return static_cast<double>(page_rank_[target])
+                                      * static_cast<double>(edge_probability);
+                              });
+
+                          temp_page_rank_[current_node] = (1 - dumping_factor) + dumping_factor * sum;
+                      });
+    });
 }
 
 auto WeightedPageRank::precalculateWeightedSums() noexcept